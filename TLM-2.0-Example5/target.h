@@ -13,7 +13,7 @@ struct Memory: sc_module
   const sc_time LATENCY;
 
   SC_CTOR(Memory)
-  : socket("socket"), LATENCY(10, SC_NS)
+  : socket("socket"), LATENCY(10, SC_NS), m_random(name())
   {
     socket.register_b_transport(       this, &Memory::b_transport);
     socket.register_get_direct_mem_ptr(this, &Memory::get_direct_mem_ptr);
@@ -21,7 +21,7 @@ struct Memory: sc_module
 
     // Initialize memory with random data
     for (int i = 0; i < SIZE; i++)
-      mem[i] = 0xAA000000 | (mem_nr << 20) | (rand() % 256);
+      mem[i] = 0xAA000000 | (mem_nr << 20) | m_random.below(256);
 
     // Each instance is given identifiable contents to help debug
     ++mem_nr;
@@ -110,6 +110,7 @@ struct Memory: sc_module
 
   int mem[SIZE];
   static unsigned int mem_nr;  // Unique memory number to help debug
+  Random_stream m_random;
 };
 
 unsigned int Memory::mem_nr = 0;
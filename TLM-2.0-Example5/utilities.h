@@ -7,6 +7,7 @@ using namespace sc_dt;
 using namespace std;
 
 #include "tlm.h"
+#include "random_source.h"
 
 // **************************************************************************************
 // User-defined memory manager, which maintains a pool of transactions
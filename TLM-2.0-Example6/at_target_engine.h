@@ -0,0 +1,369 @@
+
+// Filename: at_target_engine.h
+
+//----------------------------------------------------------------------
+//  Licensed under the Apache License, Version 2.0 (the "License");
+//  you may not use this file except in compliance with the License.
+//  You may obtain a copy of the License at
+//
+//  http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+//----------------------------------------------------------------------
+
+// Version 1  16-Oct-2026
+// Version 2  16-Oct-2026  Latency drawn from random streams and delay distributions
+// Version 3  16-Oct-2026  All deferred END_REQs issued when the pipeline has room; BEGIN_REQ time kept on the payload
+
+
+// *******************************************************************
+// Base protocol engine shared by the pipelined AT targets
+// *******************************************************************
+
+/*
+AT_target_engine is the target side of the base protocol, with a pipeline of configurable
+depth. A transaction enters the pipeline when the target sends END_REQ and leaves it on
+END_RESP. While depth transactions are in the pipeline, END_REQ for the next request is
+held back, which puts back-pressure on the initiator. A transaction whose latency has
+elapsed is executed and then waits in a response queue of any length until the
+BEGIN_RESP/END_RESP exclusion rule allows its BEGIN_RESP.
+
+By default END_REQ is sent on the backward path. After set_return_path(true), END_REQ is
+returned on the return path whenever the pipeline has room.
+
+The delays come from a Target_latency object: the accept delay from BEGIN_REQ to END_REQ,
+and the response delay from END_REQ to BEGIN_RESP. Fixed_latency, Random_latency and
+Distribution_latency, which draws from any Delay_distribution (see random_source.h), are
+provided. The default is a Random_latency with power-law delays of up to 10 ns, drawn
+from a stream seeded by the name of the target.
+
+A target derived from the engine overrides check_request to reject requests it cannot
+handle, execute to carry out the command, and transfer_latency to add a delay that
+depends on the transaction, such as the beats of a burst.
+
+The engine keeps the number of responses, their mean and worst latency from BEGIN_REQ to
+BEGIN_RESP, and the peak number of transactions in the pipeline.
+*/
+
+#ifndef __AT_TARGET_ENGINE_H__
+#define __AT_TARGET_ENGINE_H__
+
+#include "systemc"
+#include "tlm.h"
+#include "tlm_utils/simple_target_socket.h"
+#include "tlm_utils/peq_with_cb_and_phase.h"
+
+#include "random_source.h"
+
+#include <deque>
+#include <string>
+
+DECLARE_EXTENDED_PHASE(response_ready_ph);
+
+
+// The time of BEGIN_REQ, kept with the request for the latency statistics. It is set as an
+// ordinary extension, so it stays on a pooled payload and is allocated once per payload
+// rather than once per transaction
+struct begin_req_ext: tlm::tlm_extension<begin_req_ext>
+{
+  virtual tlm_extension_base* clone() const
+  {
+    begin_req_ext* ext = new begin_req_ext;
+    ext->time = time;
+    return ext;
+  }
+
+  virtual void copy_from( tlm_extension_base const& ext )
+  {
+    time = static_cast<begin_req_ext const&>(ext).time;
+  }
+
+  sc_core::sc_time time;
+};
+
+
+struct Target_latency
+{
+  virtual ~Target_latency() {}
+
+  virtual sc_core::sc_time accept_delay( const tlm::tlm_generic_payload& trans ) = 0;
+  virtual sc_core::sc_time response_delay( const tlm::tlm_generic_payload& trans ) = 0;
+};
+
+struct Fixed_latency: Target_latency
+{
+  Fixed_latency( const sc_core::sc_time& accept, const sc_core::sc_time& response )
+  : m_accept(accept), m_response(response) {}
+
+  sc_core::sc_time accept_delay( const tlm::tlm_generic_payload& )   { return m_accept; }
+  sc_core::sc_time response_delay( const tlm::tlm_generic_payload& ) { return m_response; }
+
+  sc_core::sc_time m_accept;
+  sc_core::sc_time m_response;
+};
+
+// Power-law distributed delays of up to 10 ns, to stress the protocol
+struct Random_latency: Target_latency
+{
+  Random_latency( const char* name )
+  : m_random(name), m_delay( sc_core::sc_time(9703, sc_core::SC_PS) ) {}
+
+  sc_core::sc_time accept_delay( const tlm::tlm_generic_payload& )   { return m_delay.sample(m_random); }
+  sc_core::sc_time response_delay( const tlm::tlm_generic_payload& ) { return m_delay.sample(m_random); }
+
+  Random_stream   m_random;
+  Power_law_delay m_delay;
+};
+
+// The distributions are not owned by the latency model
+struct Distribution_latency: Target_latency
+{
+  Distribution_latency( Delay_distribution& accept, Delay_distribution& response, const char* name )
+  : m_accept(accept), m_response(response), m_random(name) {}
+
+  sc_core::sc_time accept_delay( const tlm::tlm_generic_payload& )   { return m_accept.sample(m_random); }
+  sc_core::sc_time response_delay( const tlm::tlm_generic_payload& ) { return m_response.sample(m_random); }
+
+  Delay_distribution& m_accept;
+  Delay_distribution& m_response;
+  Random_stream       m_random;
+};
+
+
+struct AT_target_engine: sc_core::sc_module
+{
+  tlm_utils::simple_target_socket<AT_target_engine, 32> socket;
+
+  AT_target_engine( sc_core::sc_module_name name, unsigned int depth = 2, Target_latency* latency = 0 )
+  : sc_core::sc_module(name)
+  , socket("socket")
+  , n_trans(0)
+  , response_in_progress(false)
+  , n_responses(0)
+  , total_latency(sc_core::SC_ZERO_TIME)
+  , max_latency(sc_core::SC_ZERO_TIME)
+  , peak_trans(0)
+  , m_depth(depth ? depth : 1)
+  , m_latency(latency ? latency : &m_random_latency)
+  , m_random_latency( (std::string(this->name()) + ".latency").c_str() )
+  , m_return_path(false)
+  , m_peq(this, &AT_target_engine::peq_cb)
+  {
+    socket.register_nb_transport_fw(this, &AT_target_engine::nb_transport_fw);
+  }
+
+  // Maximum number of transactions between END_REQ and END_RESP
+  void set_depth( unsigned int depth ) { m_depth = depth ? depth : 1; }
+  unsigned int get_depth() const       { return m_depth; }
+
+  // The latency model is not owned by the engine
+  void set_latency( Target_latency* latency ) { m_latency = latency ? latency : &m_random_latency; }
+
+  void set_return_path( bool on ) { m_return_path = on; }
+
+  sc_core::sc_time mean_latency() const
+  {
+    return n_responses ? total_latency / double(n_responses) : sc_core::SC_ZERO_TIME;
+  }
+
+  virtual tlm::tlm_sync_enum nb_transport_fw( tlm::tlm_generic_payload& trans,
+                                              tlm::tlm_phase& phase, sc_core::sc_time& delay )
+  {
+    if (phase == tlm::BEGIN_REQ && !check_request(trans))
+      return tlm::TLM_COMPLETED;
+
+    if (phase == tlm::BEGIN_REQ && m_return_path && n_trans < m_depth)
+    {
+      trans.acquire();
+      set_begin_time( trans, sc_core::sc_time_stamp() + delay );
+
+      phase = tlm::END_REQ;
+      delay = delay + m_latency->accept_delay(trans);
+      enter_pipeline( trans, delay );
+      return tlm::TLM_UPDATED;
+    }
+
+    m_peq.notify( trans, phase, delay );
+    return tlm::TLM_ACCEPTED;
+  }
+
+  void peq_cb( tlm::tlm_generic_payload& trans, const tlm::tlm_phase& phase )
+  {
+    switch (phase) {
+    case tlm::BEGIN_REQ:
+
+      trans.acquire();
+      set_begin_time( trans, sc_core::sc_time_stamp() );
+
+      // Put back-pressure on the initiator by deferring END_REQ until the pipeline has room
+      if (n_trans >= m_depth)
+        end_req_pending.push_back(&trans);
+      else
+        send_end_req(trans);
+      break;
+
+    case tlm::END_RESP:
+      // On receiving END_RESP, the target can release the transaction
+      // and allow other pending transactions to proceed
+
+      if (!response_in_progress)
+        SC_REPORT_FATAL("TLM-2", "Illegal transaction phase END_RESP received by target");
+
+      leave_pipeline(trans);
+      send_responses();
+      break;
+
+    case tlm::END_REQ:
+    case tlm::BEGIN_RESP:
+      SC_REPORT_FATAL("TLM-2", "Illegal transaction phase received by target");
+      break;
+
+    default:
+      if (phase == response_ready_ph)
+      {
+        execute(trans);
+
+        // Target must honor BEGIN_RESP/END_RESP exclusion rule
+        // i.e. must not send BEGIN_RESP until receiving previous END_RESP or BEGIN_REQ
+        response_queue.push_back(&trans);
+        send_responses();
+      }
+    }
+  }
+
+  // Returns false, having set the response status, for a request the target cannot handle
+  virtual bool check_request( tlm::tlm_generic_payload& trans ) { return true; }
+
+  // Carries out the command when the latency has elapsed
+  virtual void execute( tlm::tlm_generic_payload& trans )
+  {
+    trans.set_response_status( tlm::TLM_OK_RESPONSE );
+  }
+
+  // Delay added to the response delay of the latency model
+  virtual sc_core::sc_time transfer_latency( const tlm::tlm_generic_payload& trans )
+  {
+    return sc_core::SC_ZERO_TIME;
+  }
+
+  unsigned int n_trans;
+  bool         response_in_progress;
+  std::deque<tlm::tlm_generic_payload*> end_req_pending;
+  std::deque<tlm::tlm_generic_payload*> response_queue;
+
+  // Statistics
+  sc_dt::uint64    n_responses;
+  sc_core::sc_time total_latency;
+  sc_core::sc_time max_latency;
+  unsigned int     peak_trans;
+
+private:
+
+  void send_end_req( tlm::tlm_generic_payload& trans )
+  {
+    tlm::tlm_phase bw_phase = tlm::END_REQ;
+    sc_core::sc_time delay = m_latency->accept_delay(trans);
+
+    tlm::tlm_sync_enum status = socket->nb_transport_bw( trans, bw_phase, delay );
+    if (status == tlm::TLM_COMPLETED)
+    {
+      // Transaction aborted by the initiator
+      // (TLM_UPDATED cannot occur at this point in the base protocol, so need not be checked)
+      trans.release();
+      return;
+    }
+    enter_pipeline( trans, delay );
+  }
+
+  // Queue internal event to mark beginning of response
+  void enter_pipeline( tlm::tlm_generic_payload& trans, const sc_core::sc_time& accept )
+  {
+    tlm::tlm_phase int_phase = response_ready_ph;
+    sc_core::sc_time delay = accept + m_latency->response_delay(trans) + transfer_latency(trans);
+    m_peq.notify( trans, int_phase, delay );
+
+    if (++n_trans > peak_trans)
+      peak_trans = n_trans;
+  }
+
+  void leave_pipeline( tlm::tlm_generic_payload& trans )
+  {
+    trans.release();
+    n_trans--;
+    response_in_progress = false;
+
+    // The pipeline has room, so unblock the initiator by issuing END_REQ. An initiator may
+    // complete a request on END_REQ, leaving room for the next one without any END_RESP
+    while (n_trans < m_depth && !end_req_pending.empty())
+    {
+      tlm::tlm_generic_payload* next = end_req_pending.front();
+      end_req_pending.pop_front();
+      send_end_req( *next );
+    }
+  }
+
+  void set_begin_time( tlm::tlm_generic_payload& trans, const sc_core::sc_time& t )
+  {
+    begin_req_ext* ext;
+    trans.get_extension(ext);
+    if (!ext)
+    {
+      ext = new begin_req_ext;
+      trans.set_extension(ext);
+    }
+    ext->time = t;
+  }
+
+  void send_responses()
+  {
+    while (!response_in_progress && !response_queue.empty())
+    {
+      tlm::tlm_generic_payload* trans = response_queue.front();
+      response_queue.pop_front();
+      send_response( *trans );
+    }
+  }
+
+  void send_response( tlm::tlm_generic_payload& trans )
+  {
+    begin_req_ext* ext;
+    trans.get_extension(ext);
+    if (ext)
+    {
+      sc_core::sc_time latency = sc_core::sc_time_stamp() - ext->time;
+      n_responses++;
+      total_latency += latency;
+      if (latency > max_latency)
+        max_latency = latency;
+    }
+
+    response_in_progress = true;
+    tlm::tlm_phase bw_phase = tlm::BEGIN_RESP;
+    sc_core::sc_time delay = sc_core::SC_ZERO_TIME;
+    tlm::tlm_sync_enum status = socket->nb_transport_bw( trans, bw_phase, delay );
+
+    if (status == tlm::TLM_UPDATED)
+    {
+      // The timing annotation must be honored
+      m_peq.notify( trans, bw_phase, delay );
+    }
+    else if (status == tlm::TLM_COMPLETED)
+    {
+      // The initiator has terminated the transaction
+      leave_pipeline(trans);
+    }
+  }
+
+  unsigned int    m_depth;
+  Target_latency* m_latency;
+  Random_latency  m_random_latency;
+  bool            m_return_path;
+
+  tlm_utils::peq_with_cb_and_phase<AT_target_engine> m_peq;
+};
+
+#endif
@@ -0,0 +1,215 @@
+
+// Filename: binary_log.h
+
+//----------------------------------------------------------------------
+//  Licensed under the Apache License, Version 2.0 (the "License");
+//  you may not use this file except in compliance with the License.
+//  You may obtain a copy of the License at
+//
+//  http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+//----------------------------------------------------------------------
+
+// Version 1  16-Oct-2026
+
+
+// *******************************************************************
+// File of fixed-size binary records, written by a background thread
+// *******************************************************************
+
+/*
+Binary_log<R> appends records of type R, which must be trivially copyable, to a ring
+buffer in memory. A host thread started by open() drains the ring to the file in large
+blocks, so the simulation thread never waits for the disk unless the ring fills up, in
+which case append() yields until there is room again.
+
+The ring has a single producer and a single consumer and needs no lock: the producer
+only advances the tail and the consumer only advances the head. append() must therefore
+always be called from the same thread, normally the SystemC kernel thread.
+
+The file starts with an 8-byte magic string and the size of one record as a 32-bit word,
+so that a reader can reject a file written with a different record layout.
+Binary_log_reader<R> reads the records back in blocks.
+*/
+
+#ifndef __BINARY_LOG_H__
+#define __BINARY_LOG_H__
+
+#include "systemc"
+
+#include <atomic>
+#include <thread>
+#include <chrono>
+#include <vector>
+#include <cstdio>
+#include <cstring>
+
+template <typename R>
+class Binary_log
+{
+public:
+  // capacity is the number of records in the ring, rounded up to a power of two
+  Binary_log( unsigned int capacity = 1 << 16 )
+  : m_file(0)
+  , m_head(0)
+  , m_tail(0)
+  , m_stop(false)
+  , m_written(0)
+  {
+    unsigned int n = 1;
+    while (n < capacity)
+      n <<= 1;
+    m_ring.resize(n);
+    m_mask = n - 1;
+  }
+
+  ~Binary_log() { close(); }
+
+  bool open( const char* filename, const char* magic )
+  {
+    close();
+    m_file = fopen( filename, "wb" );
+    if (!m_file)
+      return false;
+
+    char header[8];
+    memset( header, 0, sizeof(header) );
+    strncpy( header, magic, sizeof(header) );
+    unsigned int size = sizeof(R);
+    fwrite( header, 1, sizeof(header), m_file );
+    fwrite( &size, sizeof(size), 1, m_file );
+
+    m_head.store(0);
+    m_tail.store(0);
+    m_stop.store(false);
+    m_written = 0;
+    m_thread = std::thread( &Binary_log::drain, this );
+    return true;
+  }
+
+  // Writes out the records still in the ring and closes the file
+  void close()
+  {
+    if (!m_file)
+      return;
+    m_stop.store(true, std::memory_order_release);
+    m_thread.join();
+    fclose( m_file );
+    m_file = 0;
+  }
+
+  bool is_open() const { return m_file != 0; }
+
+  void append( const R& r )
+  {
+    sc_dt::uint64 t = m_tail.load(std::memory_order_relaxed);
+    while (t - m_head.load(std::memory_order_acquire) > m_mask)
+      std::this_thread::yield();
+
+    m_ring[t & m_mask] = r;
+    m_tail.store(t + 1, std::memory_order_release);
+  }
+
+  // Records written to the file so far. Only exact after close()
+  sc_dt::uint64 written() const { return m_written; }
+
+private:
+  void drain()
+  {
+    for (;;)
+    {
+      bool stop = m_stop.load(std::memory_order_acquire);
+      sc_dt::uint64 h = m_head.load(std::memory_order_relaxed);
+      sc_dt::uint64 t = m_tail.load(std::memory_order_acquire);
+
+      if (h == t)
+      {
+        if (stop)
+          break;
+        std::this_thread::sleep_for( std::chrono::microseconds(100) );
+        continue;
+      }
+
+      // Write the records up to the end of the ring, then the rest on the next pass
+      sc_dt::uint64 end = t;
+      if ((h & ~sc_dt::uint64(m_mask)) != (t & ~sc_dt::uint64(m_mask)))
+        end = (h | m_mask) + 1;
+
+      fwrite( &m_ring[h & m_mask], sizeof(R), end - h, m_file );
+      m_written += end - h;
+      m_head.store(end, std::memory_order_release);
+    }
+    fflush( m_file );
+  }
+
+  FILE*                      m_file;
+  std::vector<R>             m_ring;
+  sc_dt::uint64              m_mask;
+  std::atomic<sc_dt::uint64> m_head;
+  std::atomic<sc_dt::uint64> m_tail;
+  std::atomic<bool>          m_stop;
+  sc_dt::uint64              m_written;
+  std::thread                m_thread;
+};
+
+
+template <typename R>
+class Binary_log_reader
+{
+public:
+  Binary_log_reader( unsigned int block = 1 << 14 )
+  : m_file(0), m_block(block ? block : 1), m_next(0), m_end(0) {}
+
+  ~Binary_log_reader() { if (m_file) fclose(m_file); }
+
+  // Fails if the file cannot be opened or was not written with the same magic and record
+  bool open( const char* filename, const char* magic )
+  {
+    m_file = fopen( filename, "rb" );
+    if (!m_file)
+      return false;
+
+    char header[8], expected[8];
+    unsigned int size = 0;
+    memset( expected, 0, sizeof(expected) );
+    strncpy( expected, magic, sizeof(expected) );
+    if (fread( header, 1, sizeof(header), m_file ) != sizeof(header)
+     || fread( &size, sizeof(size), 1, m_file ) != 1
+     || memcmp( header, expected, sizeof(header) ) != 0
+     || size != sizeof(R))
+    {
+      fclose( m_file );
+      m_file = 0;
+      return false;
+    }
+    m_buffer.resize(m_block);
+    return true;
+  }
+
+  bool next( R& r )
+  {
+    if (m_next == m_end)
+    {
+      m_end  = fread( &m_buffer[0], sizeof(R), m_block, m_file );
+      m_next = 0;
+      if (m_end == 0)
+        return false;
+    }
+    r = m_buffer[m_next++];
+    return true;
+  }
+
+private:
+  FILE*          m_file;
+  unsigned int   m_block;
+  std::vector<R> m_buffer;
+  std::size_t    m_next;
+  std::size_t    m_end;
+};
+
+#endif
@@ -19,6 +19,7 @@ struct Initiator: sc_module
   : socket("socket")  // Construct and name socket
   , request_in_progress(0)
   , m_peq(this, &Initiator::peq_cb)
+  , m_random(name())
   {
     // Register callbacks for incoming interface method calls
     socket.register_nb_transport_bw(this, &Initiator::nb_transport_bw);
@@ -35,9 +36,9 @@ struct Initiator: sc_module
     // Generate a sequence of random transactions
     for (int i = 0; i < 1000; i++)
     {
-      int adr = rand();
-      tlm::tlm_command cmd = static_cast<tlm::tlm_command>(rand() % 2);
-      if (cmd == tlm::TLM_WRITE_COMMAND) data[i % 16] = rand();
+      int adr = int(m_random.next() & 0x7FFFFFFF);
+      tlm::tlm_command cmd = static_cast<tlm::tlm_command>(m_random.below(2));
+      if (cmd == tlm::TLM_WRITE_COMMAND) data[i % 16] = int(m_random.next() & 0x7FFFFFFF);
 
       // Grab a new transaction from the memory manager
       trans = m_mm.allocate();
@@ -60,10 +61,9 @@ struct Initiator: sc_module
       phase = tlm::BEGIN_REQ;
 
       // Timing annotation models processing time of initiator prior to call
-      delay = sc_time(rand_ps(), SC_PS);
+      delay = sc_time(rand_ps(m_random), SC_PS);
 
-      fout << hex << adr << " " << name() << " new, cmd=" << (cmd ? 'W' : 'R')
-           << ", data=" << hex << data[i % 16] << " at time " << sc_time_stamp() << endl;
+      trans_log.record( this, Transaction_record::NEW, cmd, adr, data[i % 16] );
 
       // Non-blocking transport call on the forward path
       tlm::tlm_sync_enum status;
@@ -83,7 +83,7 @@ struct Initiator: sc_module
         // The target has terminated the transaction
         check_transaction( *trans );
       }
-      wait( sc_time(rand_ps(), SC_PS) );
+      wait( sc_time(rand_ps(m_random), SC_PS) );
     }
 
     wait(100, SC_NS);
@@ -100,9 +100,9 @@ struct Initiator: sc_module
     trans->set_dmi_allowed( false ); // Mandatory initial value
     trans->set_response_status( tlm::TLM_INCOMPLETE_RESPONSE ); // Mandatory initial value
 
-    delay = sc_time(rand_ps(), SC_PS);
+    delay = sc_time(rand_ps(m_random), SC_PS);
 
-    fout << "Calling b_transport at " << sc_time_stamp() << " with delay = " << delay << endl;
+    trans_log.record( this, Transaction_record::B_TRANSPORT, tlm::TLM_WRITE_COMMAND, delay.value(), 0 );
 
     // Call b_transport to demonstrate the b/nb conversion by the simple_target_socket
     socket->b_transport( *trans, delay );
@@ -125,10 +125,8 @@ struct Initiator: sc_module
   void peq_cb(tlm::tlm_generic_payload& trans, const tlm::tlm_phase& phase)
   {
     #ifdef DEBUG
-      if (phase == tlm::END_REQ)
-        fout << hex << trans.get_address() << " " << name() << " END_REQ at " << sc_time_stamp() << endl;
-      else if (phase == tlm::BEGIN_RESP)
-        fout << hex << trans.get_address() << " " << name() << " BEGIN_RESP at " << sc_time_stamp() << endl;
+      if (phase == tlm::END_REQ || phase == tlm::BEGIN_RESP)
+        trans_log.record( this, Transaction_record::PHASE, trans.get_command(), trans.get_address(), 0, phase );
     #endif
 
     if (phase == tlm::END_REQ || (&trans == request_in_progress && phase == tlm::BEGIN_RESP))
@@ -146,7 +144,7 @@ struct Initiator: sc_module
 
       // Send final phase transition to target
       tlm::tlm_phase fw_phase = tlm::END_RESP;
-      sc_time delay = sc_time(rand_ps(), SC_PS);
+      sc_time delay = sc_time(rand_ps(m_random), SC_PS);
       socket->nb_transport_fw( trans, fw_phase, delay );
       // Ignore return value
     }
@@ -167,8 +165,7 @@ struct Initiator: sc_module
     sc_dt::uint64    adr = trans.get_address();
     int*             ptr = reinterpret_cast<int*>( trans.get_data_ptr() );
 
-    fout << hex << adr << " " << name() << " check, cmd=" << (cmd ? 'W' : 'R')
-         << ", data=" << hex << *ptr << " at time " << sc_time_stamp() << endl;
+    trans_log.record( this, Transaction_record::CHECK, cmd, adr, *ptr );
 
     // Allow the memory manager to free the transaction object
     trans.release();
@@ -179,6 +176,7 @@ struct Initiator: sc_module
   tlm::tlm_generic_payload* request_in_progress;
   sc_event end_request_event;
   tlm_utils::peq_with_cb_and_phase<Initiator> m_peq;
+  Random_stream m_random;
 };
 
 #endif
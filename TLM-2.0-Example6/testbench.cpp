@@ -17,6 +17,7 @@
 // Version 1, 26-June-2008
 // Version 2,  7-July-2008  Remove N_INITIATORS, N_TARGETS template parameters from Bus
 // Version 3   8-March-2010 Replaced target end_req_pending pointer with a queue
+// Version 4  16-Oct-2026   Log transactions through Transaction_log, in binary unless -text
 
 // Getting Started with TLM-2.0, Example 6
 
@@ -31,11 +32,26 @@
 
 int sc_main(int argc, char* argv[])
 {
+  if (argc < 2 || string(argv[1]) != "-text")
+    trans_log.open("output.bin");
+
   Top top("top");
   sc_start();
 
-  cout << "\n***** Messages have been written to file output.txt                    *****\n";
-  cout << "***** Select 'Download files after run' to read file in EDA Playground *****\n\n";
+  // Payloads still referenced, when compiled with -DMM_ACCOUNTING
+  MM_ACCOUNT( report(cout) );
+
+  if (trans_log.is_open())
+  {
+    trans_log.close();
+    cout << "\n***** Messages have been logged to file output.bin, run with -text or *****\n";
+    cout << "***** decode it with tools/trans_decode output.bin output.txt          *****\n\n";
+  }
+  else
+  {
+    cout << "\n***** Messages have been written to file output.txt                    *****\n";
+    cout << "***** Select 'Download files after run' to read file in EDA Playground *****\n\n";
+  }
 
   return 0;
 }
@@ -7,10 +7,16 @@ using namespace sc_dt;
 using namespace std;
 
 #include "tlm.h"
+#include "random_source.h"
+#include "transaction_log.h"
+#include "mm_accounting.h"
 #include <fstream>
 
 static ofstream fout("output.txt");
 
+// Records the events of the initiators and targets, by default as text in fout
+static Transaction_log trans_log(fout, Transaction_record::EXAMPLE6);
+
 // **************************************************************************************
 // User-defined memory manager, which maintains a pool of transactions
 // **************************************************************************************
@@ -22,6 +28,9 @@ class mm: public tlm::tlm_mm_interface
 public:
   mm() : free_list(0), empties(0) {}
 
+  // Deletes the pooled payloads, and every node of the free list
+  ~mm();
+
   gp_t* allocate();
   void  free(gp_t* trans);
 
@@ -51,11 +60,14 @@ mm::gp_t* mm::allocate()
   {
     ptr = new gp_t(this);
   }
+  MM_ACCOUNT( on_allocate(this, ptr) );
   return ptr;
 }
 
 void mm::free(gp_t* trans)
 {
+  MM_ACCOUNT( on_free(this, trans) );
+  trans->reset(); // Delete auto extensions
   if (!empties)
   {
     empties = new access;
@@ -69,13 +81,33 @@ void mm::free(gp_t* trans)
   empties = free_list->prev;
 }
 
+mm::~mm()
+{
+  MM_ACCOUNT( on_destroy(this) );
+
+  // The nodes holding payloads follow free_list, and the empty nodes precede it
+  while (free_list)
+  {
+    access* next = free_list->next;
+    delete free_list->trans;
+    delete free_list;
+    free_list = next;
+  }
+  while (empties)
+  {
+    access* prev = empties->prev;
+    delete empties;
+    empties = prev;
+  }
+}
+
 
 // Generate a random delay (with power-law distribution) to aid testing and stress the protocol
-int rand_ps()
+// Each module passes its own stream, so that its delays do not depend on the other modules
+int rand_ps( Random_stream& random )
 {
-  int n = rand() % 100;
-  n = n * n * n;
-  return n / 100;
+  double u = random.uniform();
+  return int(u * u * u * 9703);
 }
 
 #endif
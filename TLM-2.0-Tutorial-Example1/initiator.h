@@ -8,6 +8,7 @@ using namespace std;
 
 #include "tlm.h"
 #include "tlm_utils/simple_initiator_socket.h"
+#include "random_source.h"
 
 
 // Initiator module generating generic payload transactions
@@ -19,6 +20,7 @@ struct Initiator: sc_module
 
   SC_CTOR(Initiator)
   : socket("socket")  // Construct and name socket
+  , m_random(name())
   {
     SC_THREAD(thread_process);
   }
@@ -33,7 +35,7 @@ struct Initiator: sc_module
     for (int i = 32; i < 96; i += 4)
     {
 
-      tlm::tlm_command cmd = static_cast<tlm::tlm_command>(rand() % 2);
+      tlm::tlm_command cmd = static_cast<tlm::tlm_command>(m_random.below(2));
       if (cmd == tlm::TLM_WRITE_COMMAND) data = 0xFF000000 | i;
 
       // Initialize 8 out of the 10 attributes, byte_enable_length and extensions being unused
@@ -63,6 +65,8 @@ struct Initiator: sc_module
 
   // Internal data buffer used by initiator with generic payload
   int data;
+
+  Random_stream m_random;
 };
 
 #endif
@@ -11,6 +11,7 @@ using namespace std;
 
 #include "tlm.h"
 #include "tlm_utils/simple_target_socket.h"
+#include "random_source.h"
 
 
 // Target module representing a simple memory
@@ -23,14 +24,14 @@ struct Memory: sc_module
   enum { SIZE = 256 };
 
   SC_CTOR(Memory)
-  : socket("socket")
+  : socket("socket"), m_random(name())
   {
     // Register callback for incoming b_transport interface method call
     socket.register_b_transport(this, &Memory::b_transport);
 
     // Initialize memory with random data
     for (int i = 0; i < SIZE; i++)
-      mem[i] = 0xAA000000 | (rand() % 256);
+      mem[i] = 0xAA000000 | m_random.below(256);
   }
 
   // TLM-2 blocking transport method
@@ -62,6 +63,7 @@ struct Memory: sc_module
   }
 
   int mem[SIZE];
+  Random_stream m_random;
 };
 
 #endif
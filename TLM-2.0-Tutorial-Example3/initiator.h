@@ -8,6 +8,7 @@ using namespace std;
 
 #include "tlm.h"
 #include "tlm_utils/simple_initiator_socket.h"
+#include "random_source.h"
 
 
 // Initiator module generating generic payload transactions
@@ -19,7 +20,8 @@ struct Initiator: sc_module
 
   SC_CTOR(Initiator)
   : socket("socket"),  // Construct and name socket
-    dmi_ptr_valid(false)
+    dmi_ptr_valid(false),
+    m_random(name())
   {
     // Register callbacks for incoming interface method calls
     socket.register_invalidate_direct_mem_ptr(this, &Initiator::invalidate_direct_mem_ptr);
@@ -37,7 +39,7 @@ struct Initiator: sc_module
     for (int i = 256-64; i < 256+64; i += 4)
     {
       int data;
-      tlm::tlm_command cmd = static_cast<tlm::tlm_command>(rand() % 2);
+      tlm::tlm_command cmd = static_cast<tlm::tlm_command>(m_random.below(2));
       if (cmd == tlm::TLM_WRITE_COMMAND) data = 0xFF000000 | i;
 
       // Use DMI if it is available
@@ -150,6 +152,7 @@ struct Initiator: sc_module
 
   bool dmi_ptr_valid;
   tlm::tlm_dmi dmi_data;
+  Random_stream m_random;
 };
 
 #endif
@@ -11,6 +11,7 @@ using namespace std;
 
 #include "tlm.h"
 #include "tlm_utils/simple_target_socket.h"
+#include "random_source.h"
 
 
 // Target module representing a simple memory
@@ -24,7 +25,7 @@ struct Memory: sc_module
   const sc_time LATENCY;
 
   SC_CTOR(Memory)
-  : socket("socket"), LATENCY(10, SC_NS)
+  : socket("socket"), LATENCY(10, SC_NS), m_random(name())
   {
     // Register callbacks for incoming interface method calls
     socket.register_b_transport(       this, &Memory::b_transport);
@@ -33,7 +34,7 @@ struct Memory: sc_module
 
     // Initialize memory with random data
     for (int i = 0; i < SIZE; i++)
-      mem[i] = 0xAA000000 | (mem_nr << 20) | (rand() % 256);
+      mem[i] = 0xAA000000 | (mem_nr << 20) | m_random.below(256);
 
     ++mem_nr;
   }
@@ -119,6 +120,7 @@ struct Memory: sc_module
   }
 
   int mem[SIZE];
+  Random_stream m_random;
   static unsigned int mem_nr;
 };
 
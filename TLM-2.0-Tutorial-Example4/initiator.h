@@ -19,6 +19,7 @@ struct Initiator: sc_module
   : socket("socket")  // Construct and name socket
   , request_in_progress(0)
   , m_peq(this, &Initiator::peq_cb)
+  , m_random(name())
   {
     // Register callbacks for incoming interface method calls
     socket.register_nb_transport_bw(this, &Initiator::nb_transport_bw);
@@ -35,9 +36,9 @@ struct Initiator: sc_module
     // Generate a sequence of random transactions
     for (int i = 0; i < 1000; i++)
     {
-      int adr = rand();
-      tlm::tlm_command cmd = static_cast<tlm::tlm_command>(rand() % 2);
-      if (cmd == tlm::TLM_WRITE_COMMAND) data[i % 16] = rand();
+      int adr = int(m_random.next() & 0x7FFFFFFF);
+      tlm::tlm_command cmd = static_cast<tlm::tlm_command>(m_random.below(2));
+      if (cmd == tlm::TLM_WRITE_COMMAND) data[i % 16] = int(m_random.next() & 0x7FFFFFFF);
 
       // Grab a new transaction from the memory manager
       trans = m_mm.allocate();
@@ -60,7 +61,7 @@ struct Initiator: sc_module
       phase = tlm::BEGIN_REQ;
 
       // Timing annotation models processing time of initiator prior to call
-      delay = sc_time(rand_ps(), SC_PS);
+      delay = sc_time(rand_ps(m_random), SC_PS);
 
       fout << hex << adr << " new, cmd=" << (cmd ? 'W' : 'R')
            << ", data=" << hex << data[i % 16] << " at time " << sc_time_stamp() << endl;
@@ -83,7 +84,7 @@ struct Initiator: sc_module
         // The target has terminated the transaction
         check_transaction( *trans );
       }
-      wait( sc_time(rand_ps(), SC_PS) );
+      wait( sc_time(rand_ps(m_random), SC_PS) );
     }
 
     wait(100, SC_NS);
@@ -100,7 +101,7 @@ struct Initiator: sc_module
     trans->set_dmi_allowed( false ); // Mandatory initial value
     trans->set_response_status( tlm::TLM_INCOMPLETE_RESPONSE ); // Mandatory initial value
 
-    delay = sc_time(rand_ps(), SC_PS);
+    delay = sc_time(rand_ps(m_random), SC_PS);
 
     fout << "Calling b_transport at " << sc_time_stamp() << " with delay = " << delay << endl;
 
@@ -146,7 +147,7 @@ struct Initiator: sc_module
 
       // Send final phase transition to target
       tlm::tlm_phase fw_phase = tlm::END_RESP;
-      sc_time delay = sc_time(rand_ps(), SC_PS);
+      sc_time delay = sc_time(rand_ps(m_random), SC_PS);
       socket->nb_transport_fw( trans, fw_phase, delay );
       // Ignore return value
     }
@@ -179,6 +180,7 @@ struct Initiator: sc_module
   tlm::tlm_generic_payload* request_in_progress;
   sc_event end_request_event;
   tlm_utils::peq_with_cb_and_phase<Initiator> m_peq;
+  Random_stream m_random;
 };
 
 #endif
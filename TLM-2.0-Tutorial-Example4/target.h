@@ -26,6 +26,7 @@ struct Target: sc_module
   , next_response_pending(0)
   , end_req_pending(0)
   , m_peq(this, &Target::peq_cb)
+  , m_random(name())
   {
     // Register callbacks for incoming interface method calls
     socket.register_nb_transport_fw(this, &Target::nb_transport_fw);
@@ -132,7 +133,7 @@ struct Target: sc_module
 
         if ( cmd == tlm::TLM_READ_COMMAND )
         {
-          *reinterpret_cast<int*>(ptr) = rand();
+          m_random.fill( ptr, 4 );
           fout << hex << adr << " Execute READ, data = " << *reinterpret_cast<int*>(ptr) << endl;
         }
         else if ( cmd == tlm::TLM_WRITE_COMMAND )
@@ -165,7 +166,7 @@ struct Target: sc_module
 
     // Queue the acceptance and the response with the appropriate latency
     bw_phase = tlm::END_REQ;
-    delay = sc_time(rand_ps(), SC_PS); // Accept delay
+    delay = sc_time(rand_ps(m_random), SC_PS); // Accept delay
     status = socket->nb_transport_bw( trans, bw_phase, delay );
     if (status == tlm::TLM_COMPLETED)
     {
@@ -176,7 +177,7 @@ struct Target: sc_module
     }
 
     // Queue internal event to mark beginning of response
-    delay = delay + sc_time(rand_ps(), SC_PS); // Latency
+    delay = delay + sc_time(rand_ps(m_random), SC_PS); // Latency
     m_peq.notify( trans, int_phase, delay );
     n_trans++;
 
@@ -213,6 +214,7 @@ struct Target: sc_module
   tlm::tlm_generic_payload*  next_response_pending;
   tlm::tlm_generic_payload*  end_req_pending;
   tlm_utils::peq_with_cb_and_phase<Target> m_peq;
+  Random_stream m_random;
 };
 
 #endif
@@ -7,6 +7,7 @@ using namespace sc_dt;
 using namespace std;
 
 #include "tlm.h"
+#include "random_source.h"
 #include <fstream>
 
 static ofstream fout("output.txt");
@@ -83,11 +84,11 @@ void mm::free(gp_t* trans)
 }
 
 // Generate a random delay (with power-law distribution) to aid testing and stress the protocol
-int rand_ps()
+// Each module passes its own stream, so that its delays do not depend on the other modules
+int rand_ps( Random_stream& random )
 {
-  int n = rand() % 100;
-  n = n * n * n;
-  return n / 100;
+  double u = random.uniform();
+  return int(u * u * u * 9703);
 }
 
 #endif
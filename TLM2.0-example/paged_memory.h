@@ -0,0 +1,195 @@
+
+// Filename: paged_memory.h
+
+//----------------------------------------------------------------------
+//  Licensed under the Apache License, Version 2.0 (the "License");
+//  you may not use this file except in compliance with the License.
+//  You may obtain a copy of the License at
+//
+//  http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+//----------------------------------------------------------------------
+
+// Version 1  16-Oct-2026
+
+
+// *******************************************************************
+// Sparse backing store for memory targets, initialized a page at a time
+// *******************************************************************
+
+/*
+Paged_memory reserves the whole memory as one anonymous mapping with MAP_NORESERVE, so
+declaring a memory of many gigabytes costs nothing until it is used: the host only
+commits the pages that are touched, and the resident set follows the footprint of the
+simulation rather than the declared size.
+
+Each page is filled on first touch, through data(), read(), write() or dmi(). The content
+of an untouched page is ZERO, a PATTERN in which every 32-bit word holds the low 32 bits
+of its own address, or RANDOM, where every 64-bit word is a hash of its address and the
+seed. The content is therefore the same whatever order the pages are touched in.
+
+The page size is 4 KB by default. With a larger page size, such as 2 MB, the mapping is
+also advised to use transparent huge pages.
+
+Since the mapping never moves, the pointer for an address stays valid for the lifetime of
+the memory. dmi() grants direct access to the aligned block of dmi_block bytes around an
+address, filling all its pages first, so that the initiator may use the pointer freely.
+*/
+
+#ifndef __PAGED_MEMORY_H__
+#define __PAGED_MEMORY_H__
+
+#include "systemc"
+
+#include <cstring>
+#include <sys/mman.h>
+
+class Paged_memory
+{
+public:
+  enum fill_t { ZERO, PATTERN, RANDOM };
+
+  Paged_memory( sc_dt::uint64 size, fill_t fill = ZERO, sc_dt::uint64 seed = 0,
+                unsigned int page_size = 4096, sc_dt::uint64 dmi_block = 1 << 20 )
+  : m_size(size)
+  , m_fill(fill)
+  , m_seed(seed)
+  , m_page_shift(0)
+  , m_touched(0)
+  {
+    while ((1u << m_page_shift) < page_size)
+      m_page_shift++;
+    m_dmi_block = dmi_block < page_size ? page_size : dmi_block;
+
+    sc_dt::uint64 n_pages = (size + page_bytes() - 1) >> m_page_shift;
+    m_mapped = n_pages << m_page_shift;
+    m_bitmap = ((n_pages + 63) / 64) * sizeof(sc_dt::uint64);
+
+    // The page bitmap is mapped lazily too, so that creation time does not grow with size
+    m_base   = static_cast<unsigned char*>( reserve(m_mapped) );
+    m_filled = static_cast<sc_dt::uint64*>( reserve(m_bitmap) );
+
+#ifdef MADV_HUGEPAGE
+    if (page_size > 4096)
+      madvise( m_base, m_mapped, MADV_HUGEPAGE );
+#endif
+  }
+
+  ~Paged_memory()
+  {
+    munmap( m_base, m_mapped ? m_mapped : 1 );
+    munmap( m_filled, m_bitmap ? m_bitmap : 1 );
+  }
+
+  sc_dt::uint64 size() const { return m_size; }
+
+  // Pointer to len bytes at addr, which must lie inside the memory
+  unsigned char* data( sc_dt::uint64 addr, unsigned int len )
+  {
+    fill_range( addr, len );
+    return m_base + addr;
+  }
+
+  void read( sc_dt::uint64 addr, unsigned char* ptr, unsigned int len )
+  {
+    memcpy( ptr, data(addr, len), len );
+  }
+
+  void write( sc_dt::uint64 addr, const unsigned char* ptr, unsigned int len )
+  {
+    memcpy( data(addr, len), ptr, len );
+  }
+
+  // Fills the DMI block containing addr and returns its bounds and pointer
+  unsigned char* dmi( sc_dt::uint64 addr, sc_dt::uint64& start, sc_dt::uint64& end )
+  {
+    start = addr - addr % m_dmi_block;
+    end   = start + m_dmi_block - 1;
+    if (end >= m_size)
+      end = m_size - 1;
+    fill_range( start, end - start + 1 );
+    return m_base + start;
+  }
+
+  bool in_range( sc_dt::uint64 addr, unsigned int len ) const
+  {
+    return addr < m_size && len <= m_size - addr;
+  }
+
+  // Number of pages filled so far, and the bytes they occupy
+  sc_dt::uint64 touched_pages() const { return m_touched; }
+  sc_dt::uint64 touched_bytes() const { return m_touched << m_page_shift; }
+
+private:
+  sc_dt::uint64 page_bytes() const { return sc_dt::uint64(1) << m_page_shift; }
+
+  static void* reserve( sc_dt::uint64 bytes )
+  {
+    void* p = mmap( 0, bytes ? bytes : 1, PROT_READ | PROT_WRITE,
+                    MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE, -1, 0 );
+    if (p == MAP_FAILED)
+      SC_REPORT_FATAL("Paged_memory", "Cannot reserve the address space for the memory");
+    return p;
+  }
+
+  void fill_range( sc_dt::uint64 addr, sc_dt::uint64 len )
+  {
+    if (len == 0)
+      return;
+    sc_dt::uint64 last = (addr + len - 1) >> m_page_shift;
+    for (sc_dt::uint64 page = addr >> m_page_shift; page <= last; page++)
+      if ( !(m_filled[page / 64] & (sc_dt::uint64(1) << (page % 64))) )
+        fill_page(page);
+  }
+
+  void fill_page( sc_dt::uint64 page )
+  {
+    m_filled[page / 64] |= sc_dt::uint64(1) << (page % 64);
+    m_touched++;
+
+    // A fresh anonymous page already reads as zero
+    if (m_fill == ZERO)
+      return;
+
+    sc_dt::uint64 base = page << m_page_shift;
+    if (m_fill == PATTERN)
+    {
+      unsigned int* w = reinterpret_cast<unsigned int*>(m_base + base);
+      for (sc_dt::uint64 i = 0; i < page_bytes() / 4; i++)
+        w[i] = (unsigned int)(base + 4 * i);
+    }
+    else
+    {
+      sc_dt::uint64* w = reinterpret_cast<sc_dt::uint64*>(m_base + base);
+      for (sc_dt::uint64 i = 0; i < page_bytes() / 8; i++)
+        w[i] = mix( (base + 8 * i) ^ m_seed );
+    }
+  }
+
+  // The splitmix64 finalizer
+  static sc_dt::uint64 mix( sc_dt::uint64 x )
+  {
+    x += 0x9E3779B97F4A7C15ULL;
+    x = (x ^ (x >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    x = (x ^ (x >> 27)) * 0x94D049BB133111EBULL;
+    return x ^ (x >> 31);
+  }
+
+  sc_dt::uint64  m_size;
+  sc_dt::uint64  m_mapped;
+  fill_t         m_fill;
+  sc_dt::uint64  m_seed;
+  unsigned int   m_page_shift;
+  sc_dt::uint64  m_dmi_block;
+  sc_dt::uint64  m_touched;
+  sc_dt::uint64  m_bitmap;
+  unsigned char* m_base;
+  sc_dt::uint64* m_filled;   // One bit per page
+};
+
+#endif
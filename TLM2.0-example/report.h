@@ -13,6 +13,30 @@
 // This is a trivial extension of the SC_REPORT_* macros to allow
 // C++ streaming syntax for more comfortable reporting in SystemC.
 // Feel free to use for your own projects.
+//
+// The message is only formatted when it would be reported. An info message
+// above the verbosity level of the report handler, or one whose actions
+// are SC_DO_NOTHING, costs a test and is not reported at all. A warning or
+// error whose actions are SC_DO_NOTHING is still reported, so that it is
+// counted by sc_report_handler::get_count(), but with an empty message.
+// The actions are those the handler would execute: the actions of the
+// MSGID and severity, or of the severity when these are unspecified, less
+// the suppress mask, plus the force mask. They are read once the MSGID has
+// been reported for the first time.
+//
+// The info messages of each MSGID can also be rate limited, for example to
+// at most 10 reports per microsecond of simulated time, or 100 over the
+// whole simulation:
+//
+//   stream_report::set_rate_limit( MSGID, 10, sc_time(1,SC_US) );
+//   stream_report::set_rate_limit( MSGID, 100 );
+//
+// The number of reports dropped in a period is reported when the next
+// period starts.
+//
+// Compile with -DSTREAM_REPORT_BUFFER_SIZE=<bytes> to format into one
+// preallocated buffer instead of a new std::ostringstream per report.
+// Longer messages are truncated.
 
 #ifndef REPORT_H
 #define REPORT_H
@@ -20,40 +44,243 @@
 #include <systemc>
 #include <sstream>
 #include <string>
+#include <map>
+
+namespace stream_report {
+
+struct msg_state
+{
+  msg_state() : md(0), limit(0), count(0), dropped(0) {}
+
+  std::string           msgid;
+  sc_core::sc_msg_def*  md;         // Set once the handler knows the MSGID
+  unsigned int          limit;      // Reports per period, 0 for no limit
+  sc_core::sc_time      period;     // SC_ZERO_TIME for the whole simulation
+  sc_core::sc_time      window_end;
+  unsigned int          count;
+  unsigned int          dropped;
+};
+
+inline msg_state& state( const char* msgid )
+{
+  static std::map<std::string, msg_state> table;
+  msg_state& s = table[msgid];
+  s.msgid = msgid;
+  return s;
+}
+
+// Caches the state of the MSGID used at one call site
+struct site
+{
+  site() : key(0), s(0) {}
+
+  msg_state& get( const char* msgid )
+  {
+    if (msgid != key)
+    {
+      s   = &state(msgid);
+      key = msgid;
+    }
+    return *s;
+  }
+
+  const char* key;
+  msg_state*  s;
+};
+
+inline void set_rate_limit( const char* msgid, unsigned int limit,
+                            const sc_core::sc_time& period = sc_core::SC_ZERO_TIME )
+{
+  msg_state& s = state(msgid);
+  s.limit      = limit;
+  s.period     = period;
+  s.window_end = sc_core::SC_ZERO_TIME;
+  s.count      = 0;
+}
+
+inline bool rate_limited( msg_state& s )
+{
+  if (sc_core::sc_time_stamp() >= s.window_end)
+  {
+    if (s.dropped)
+    {
+      std::ostringstream mout;
+      mout << s.dropped << " reports dropped by the rate limit";
+      SC_REPORT_INFO(s.msgid.c_str(),mout.str().c_str());
+    }
+    s.window_end = s.period == sc_core::SC_ZERO_TIME ? sc_core::sc_max_time()
+                                                     : sc_core::sc_time_stamp() + s.period;
+    s.count      = 0;
+    s.dropped    = 0;
+  }
+  if (s.count >= s.limit)
+  {
+    s.dropped++;
+    return true;
+  }
+  s.count++;
+  return false;
+}
+
+// The actions the handler would execute for a report of the MSGID.
+// The handler has no getters for its severity actions and masks, so each
+// is read by setting it and restoring the previous value.
+inline sc_core::sc_actions actions( msg_state& s, sc_core::sc_severity severity )
+{
+  using sc_core::sc_report_handler;
+
+  sc_core::sc_actions actions = s.md->sev_actions[severity];
+  if (actions == sc_core::SC_UNSPECIFIED)
+    actions = s.md->actions;
+  if (actions == sc_core::SC_UNSPECIFIED)
+  {
+    actions = sc_report_handler::set_actions(severity, sc_core::SC_UNSPECIFIED);
+    sc_report_handler::set_actions(severity, actions);
+  }
+  sc_core::sc_actions suppressed = sc_report_handler::suppress();
+  sc_report_handler::suppress(suppressed);
+  sc_core::sc_actions forced = sc_report_handler::force();
+  sc_report_handler::force(forced);
+  return (actions & ~suppressed) | forced;
+}
+
+// True if a report of this severity and verbosity should be formatted.
+// Only info messages are dropped when it is false; warnings and errors
+// must still reach the handler to be counted.
+inline bool enabled( msg_state& s, sc_core::sc_severity severity, int verbosity = sc_core::SC_MEDIUM )
+{
+  if (severity == sc_core::SC_INFO && verbosity > sc_core::sc_report_handler::get_verbosity_level())
+    return false;
+  if (s.md && actions(s, severity) == sc_core::SC_DO_NOTHING)
+    return false;
+  return severity != sc_core::SC_INFO || s.limit == 0 || !rate_limited(s);
+}
+
+// Called after a report, by which time the handler has a definition for the MSGID
+inline void reported( msg_state& s )
+{
+  if (!s.md)
+    s.md = sc_core::sc_report_handler::mdlookup(s.msgid.c_str());
+}
+
+#ifdef STREAM_REPORT_BUFFER_SIZE
+
+// A stream writing into one preallocated buffer, reused by every report
+class fixed_ostream: private std::streambuf, public std::ostream
+{
+public:
+  static fixed_ostream& instance()
+  {
+    static fixed_ostream os;
+    os.reset();
+    return os;
+  }
+
+  const char* c_str()
+  {
+    *pptr() = 0;
+    return m_buffer;
+  }
+
+private:
+  fixed_ostream() : std::ostream(this) { reset(); }
+
+  void reset()
+  {
+    setp( m_buffer, m_buffer + sizeof(m_buffer) - 1 );
+    clear();
+    flags( std::ios_base::dec | std::ios_base::skipws );
+    width( 0 );
+    precision( 6 );
+    fill( ' ' );
+  }
+
+  char m_buffer[STREAM_REPORT_BUFFER_SIZE + 1];
+};
+
+#endif
+
+// Prints the simulation time as sc_time does, without building a string
+struct timestamp {};
+
+inline std::ostream& operator<<( std::ostream& os, timestamp )
+{
+  static const char* units[] = { "fs", "ps", "ns", "us", "ms", "s" };
+  static const double resolution_fs = sc_core::sc_get_time_resolution().to_seconds() * 1e15 + 0.5;
+
+  sc_dt::uint64 value = sc_core::sc_time_stamp().value() * sc_dt::uint64(resolution_fs);
+  unsigned int unit = 0;
+  while (value != 0 && value % 1000 == 0 && unit < 5)
+  {
+    value /= 1000;
+    unit++;
+  }
+  if (value == 0)
+    unit = 5;
+  return os << value << " " << units[unit];
+}
+
+} // namespace stream_report
+
+#ifdef STREAM_REPORT_BUFFER_SIZE
+#define STREAM_REPORT_STREAM(mout) std::ostream& mout = stream_report::fixed_ostream::instance()
+#define STREAM_REPORT_TEXT(mout) static_cast<stream_report::fixed_ostream&>(mout).c_str()
+#define STREAM_REPORT_TIME stream_report::timestamp()
+#else
+#define STREAM_REPORT_STREAM(mout) std::ostringstream mout
+#define STREAM_REPORT_TEXT(mout) mout.str().c_str()
+#define STREAM_REPORT_TIME sc_core::sc_time_stamp()
+#endif
 
 #define STREAM_REPORT_INFO(MSGID,message_stream) \
-do {\
-  std::ostringstream mout;\
-  mout << sc_core::sc_time_stamp() << ": " << message_stream;\
-  SC_REPORT_INFO(MSGID,mout.str().c_str());\
-} while (0)
+STREAM_REPORT_INFO_VERB(MSGID,message_stream,sc_core::SC_MEDIUM)
 
 #define STREAM_REPORT_INFO_VERB(MSGID,message_stream,verbosity) \
 do {\
-  std::ostringstream mout;\
-  mout << sc_core::sc_time_stamp() << ": " << message_stream;\
-  SC_REPORT_INFO_VERB(MSGID,mout.str().c_str(),verbosity);\
+  static stream_report::site report_site;\
+  stream_report::msg_state& report_state = report_site.get(MSGID);\
+  if (stream_report::enabled(report_state,sc_core::SC_INFO,verbosity)) {\
+    STREAM_REPORT_STREAM(mout);\
+    mout << STREAM_REPORT_TIME << ": " << message_stream;\
+    SC_REPORT_INFO_VERB(MSGID,STREAM_REPORT_TEXT(mout),verbosity);\
+    stream_report::reported(report_state);\
+  }\
 } while (0)
 
 #define STREAM_REPORT_WARNING(MSGID,message_stream) \
 do {\
-  std::ostringstream mout;\
-  mout << message_stream;\
-  SC_REPORT_WARNING(MSGID,mout.str().c_str());\
+  static stream_report::site report_site;\
+  stream_report::msg_state& report_state = report_site.get(MSGID);\
+  if (stream_report::enabled(report_state,sc_core::SC_WARNING)) {\
+    STREAM_REPORT_STREAM(mout);\
+    mout << message_stream;\
+    SC_REPORT_WARNING(MSGID,STREAM_REPORT_TEXT(mout));\
+    stream_report::reported(report_state);\
+  }\
+  else\
+    SC_REPORT_WARNING(MSGID,"");\
 } while (0)
 
 #define STREAM_REPORT_ERROR(MSGID,message_stream) \
 try {\
-  std::ostringstream mout;\
-  mout << message_stream;\
-  SC_REPORT_ERROR(MSGID,mout.str().c_str());\
+  static stream_report::site report_site;\
+  stream_report::msg_state& report_state = report_site.get(MSGID);\
+  if (stream_report::enabled(report_state,sc_core::SC_ERROR)) {\
+    STREAM_REPORT_STREAM(mout);\
+    mout << message_stream;\
+    stream_report::reported(report_state);\
+    SC_REPORT_ERROR(MSGID,STREAM_REPORT_TEXT(mout));\
+  }\
+  else\
+    SC_REPORT_ERROR(MSGID,"");\
 } catch (sc_core::sc_report e) { }
 
+// Never filtered, since a fatal error must stop the simulation
 #define STREAM_REPORT_FATAL(MSGID,message_stream) \
 do {\
-  std::ostringstream mout;\
+  STREAM_REPORT_STREAM(mout);\
   mout << message_stream;\
-  SC_REPORT_FATAL(MSGID,mout.str().c_str());\
+  SC_REPORT_FATAL(MSGID,STREAM_REPORT_TEXT(mout));\
 } while (0)
 
 #endif
\ No newline at end of file
@@ -18,11 +18,10 @@ using namespace tlm;
 
 static const char* MSGID = "/Doulos/example/tlm-2.0/target";
 
-Target::Target( sc_module_name instance_name, size_t mem_size, size_t ns_latency )
-: m_memsize(mem_size), m_latency(sc_time(ns_latency,SC_NS))
+Target::Target( sc_module_name instance_name, size_t mem_size, size_t ns_latency, Paged_memory::fill_t fill )
+: m_memsize(mem_size), m_latency(sc_time(ns_latency,SC_NS)), m_storage(mem_size, fill)
 {
   targ_socket.bind( *this );
-  m_storage = new int[m_memsize];
 }
 
 void  Target::b_transport( tlm_generic_payload& trans,  sc_core::sc_time& t )
@@ -34,7 +33,7 @@ void  Target::b_transport( tlm_generic_payload& trans,  sc_core::sc_time& t )
   unsigned char*    byt = trans.get_byte_enable_ptr();
   unsigned int      wid = trans.get_streaming_width();
 
-  if( adr&3 != 0 || adr+len > m_memsize )
+  if( (adr&3) != 0 || !m_storage.in_range( adr, len ) )
   {
     trans.set_response_status( TLM_ADDRESS_ERROR_RESPONSE );
     return;
@@ -49,12 +48,13 @@ void  Target::b_transport( tlm_generic_payload& trans,  sc_core::sc_time& t )
 
   if( cmd == TLM_WRITE_COMMAND ) {
     STREAM_REPORT_INFO( MSGID, "b_transport processing WRITE to address " << adr );
-    memcpy( &m_storage[adr], ptr, len );
+    m_storage.write( adr, ptr, len );
   } else if( cmd == TLM_READ_COMMAND ) {
     STREAM_REPORT_INFO( MSGID, "b_transport processing READ from address " << adr );
-    memcpy( ptr, &m_storage[adr], len );
+    m_storage.read( adr, ptr, len );
   }
 
+  trans.set_dmi_allowed( true );
   trans.set_response_status( TLM_OK_RESPONSE );
 }
 
@@ -66,11 +66,32 @@ tlm_sync_enum  Target::nb_transport_fw( tlm_generic_payload& trans, tlm_phase& p
 }
 bool Target::get_direct_mem_ptr( tlm_generic_payload& gp, tlm_dmi& dmi )
 {
-  /* implementation not supported*/
-  return false;
+  if( !m_storage.in_range( gp.get_address(), 1 ) )
+    return false;
+
+  // Grant the block around the address; its pointer stays valid for the whole simulation
+  sc_dt::uint64 start, end;
+  dmi.set_dmi_ptr( m_storage.dmi( gp.get_address(), start, end ) );
+  dmi.set_start_address( start );
+  dmi.set_end_address( end );
+  dmi.allow_read_write();
+  dmi.set_read_latency( m_latency );
+  dmi.set_write_latency( m_latency );
+  return true;
 }
 unsigned int Target::transport_dbg( tlm_generic_payload& trans )
 {
-  /* implementation not supported */
-  return 0;
+  sc_dt::uint64 adr = trans.get_address();
+  unsigned int  len = trans.get_data_length();
+
+  if( adr >= m_storage.size() )
+    return 0;
+  if( len > m_storage.size() - adr )
+    len = (unsigned int)(m_storage.size() - adr);
+
+  if( trans.get_command() == TLM_WRITE_COMMAND )
+    m_storage.write( adr, trans.get_data_ptr(), len );
+  else if( trans.get_command() == TLM_READ_COMMAND )
+    m_storage.read( adr, trans.get_data_ptr(), len );
+  return len;
 }
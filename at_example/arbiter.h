@@ -0,0 +1,292 @@
+
+// Filename: arbiter.h
+
+//----------------------------------------------------------------------
+//  Licensed under the Apache License, Version 2.0 (the "License");
+//  you may not use this file except in compliance with the License.
+//  You may obtain a copy of the License at
+//
+//  http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+//----------------------------------------------------------------------
+
+// Version 1  16-Oct-2026
+// Version 2  16-Oct-2026  Added size()
+
+
+// *******************************************************************
+// Arbitration policies for the request queues of AT_interconnect
+// *******************************************************************
+
+/*
+AT_interconnect owns one arbiter per target socket. Requests that cannot be forwarded at once,
+because of the BEGIN_REQ/END_REQ exclusion rule, are pushed into the arbiter, and each time the
+target socket becomes free the arbiter selects which queued request to send next.
+
+Requests are held in one FIFO per initiator, so a policy only has to choose an initiator.
+Every grant, including requests forwarded at once without queueing, is counted per initiator
+together with the number of bytes and the time spent waiting for the grant.
+
+Built-in policies:
+
+  FCFS_arbiter             First-come-first-served, in order of arrival
+  Round_robin_arbiter      Cycles through the initiators, starting after the last one granted
+  Fixed_priority_arbiter   Lowest priority number wins; by default initiator 0 has top priority
+  Weighted_fair_arbiter    Shares bytes between initiators in proportion to their weights
+  Oldest_first_arbiter     Earliest request time (sc_time_stamp() + annotated delay) wins
+*/
+
+#ifndef __ARBITER_H__
+#define __ARBITER_H__
+
+#include "systemc"
+#include "tlm.h"
+
+#include <vector>
+#include <deque>
+#include <ostream>
+#include <iomanip>
+
+class Arbiter
+{
+public:
+  struct Request
+  {
+    tlm::tlm_generic_payload* trans;
+    sc_core::sc_time          time;   // Time at which the request was due to arrive
+    unsigned int              init;   // Index of interconnect target socket
+    sc_dt::uint64             seq;    // Order of arrival
+  };
+
+  Arbiter() : m_n_pending(0), m_seq(0) {}
+  virtual ~Arbiter() {}
+
+  virtual const char* kind() const = 0;
+
+  // Called from end_of_elaboration once the number of initiators is known
+  virtual void set_n_inits( unsigned int n )
+  {
+    m_queue.resize(n);
+    m_grants.resize(n, 0);
+    m_bytes.resize(n, 0);
+    m_wait.resize(n, sc_core::SC_ZERO_TIME);
+  }
+
+  bool empty() const { return m_n_pending == 0; }
+  unsigned int size() const { return m_n_pending; }
+
+  void push( tlm::tlm_generic_payload* trans, const sc_core::sc_time& time, unsigned int init )
+  {
+    Request req;
+    req.trans = trans;
+    req.time  = time;
+    req.init  = init;
+    req.seq   = m_seq++;
+
+    if (m_queue[init].empty())
+      activate(init);
+    m_queue[init].push_back(req);
+    m_n_pending++;
+  }
+
+  // Remove and return the request selected by the policy. Must not be called when empty
+  Request pop()
+  {
+    unsigned int init = select();
+    Request req = m_queue[init].front();
+    m_queue[init].pop_front();
+    m_n_pending--;
+
+    granted(req.trans, req.time, init);
+    return req;
+  }
+
+  // Account for a grant. Called directly for requests that did not need to be queued
+  void granted( tlm::tlm_generic_payload* trans, const sc_core::sc_time& time, unsigned int init )
+  {
+    m_grants[init]++;
+    m_bytes[init] += trans->get_data_length();
+    if (time < sc_core::sc_time_stamp())
+      m_wait[init] += sc_core::sc_time_stamp() - time;
+    served(init, trans->get_data_length());
+  }
+
+  unsigned int     n_inits()                    const { return m_queue.size(); }
+  sc_dt::uint64    get_grants( unsigned int i ) const { return m_grants[i]; }
+  sc_dt::uint64    get_bytes ( unsigned int i ) const { return m_bytes[i]; }
+  sc_core::sc_time get_wait  ( unsigned int i ) const { return m_wait[i]; }
+
+  void report( std::ostream& os ) const
+  {
+    sc_dt::uint64 total = 0;
+    for (unsigned int i = 0; i < n_inits(); i++)
+      total += m_bytes[i];
+
+    for (unsigned int i = 0; i < n_inits(); i++)
+    {
+      os << "  init " << std::setw(2) << i
+         << "  grants " << std::setw(8) << m_grants[i]
+         << "  bytes "  << std::setw(10) << m_bytes[i]
+         << "  share "  << std::setw(6) << std::fixed << std::setprecision(2)
+         << (total ? 100.0 * m_bytes[i] / total : 0.0) << "%"
+         << "  total wait " << m_wait[i]
+         << "\n";
+    }
+  }
+
+protected:
+  // Choose one of the initiators with a non-empty queue
+  virtual unsigned int select() = 0;
+
+  // Hooks for stateful policies
+  virtual void activate( unsigned int init ) {}
+  virtual void served( unsigned int init, unsigned int bytes ) {}
+
+  const Request* head( unsigned int init ) const
+  {
+    return m_queue[init].empty() ? 0 : &m_queue[init].front();
+  }
+
+private:
+  unsigned int                        m_n_pending;
+  sc_dt::uint64                       m_seq;
+  std::vector< std::deque<Request> >  m_queue;
+  std::vector<sc_dt::uint64>          m_grants;
+  std::vector<sc_dt::uint64>          m_bytes;
+  std::vector<sc_core::sc_time>       m_wait;
+};
+
+
+struct FCFS_arbiter: Arbiter
+{
+  const char* kind() const { return "FCFS"; }
+
+  unsigned int select()
+  {
+    unsigned int best = 0;
+    for (unsigned int i = 0; i < n_inits(); i++)
+      if (head(i) && (!head(best) || head(i)->seq < head(best)->seq))
+        best = i;
+    return best;
+  }
+};
+
+
+struct Round_robin_arbiter: Arbiter
+{
+  Round_robin_arbiter() : last(0) {}
+
+  const char* kind() const { return "round-robin"; }
+
+  unsigned int select()
+  {
+    for (unsigned int n = 1; n <= n_inits(); n++)
+    {
+      unsigned int i = (last + n) % n_inits();
+      if (head(i))
+        return last = i;
+    }
+    return last;
+  }
+
+  unsigned int last;
+};
+
+
+struct Fixed_priority_arbiter: Arbiter
+{
+  // priority[i] is the priority of initiator i; a lower number wins
+  Fixed_priority_arbiter() {}
+  Fixed_priority_arbiter( const std::vector<unsigned int>& p ) : priority(p) {}
+
+  const char* kind() const { return "fixed-priority"; }
+
+  void set_n_inits( unsigned int n )
+  {
+    Arbiter::set_n_inits(n);
+    for (unsigned int i = priority.size(); i < n; i++)
+      priority.push_back(i);
+  }
+
+  unsigned int select()
+  {
+    unsigned int best = 0;
+    for (unsigned int i = 0; i < n_inits(); i++)
+      if (head(i) && (!head(best) || priority[i] < priority[best]
+                      || (priority[i] == priority[best] && head(i)->seq < head(best)->seq)))
+        best = i;
+    return best;
+  }
+
+  std::vector<unsigned int> priority;
+};
+
+
+struct Weighted_fair_arbiter: Arbiter
+{
+  // weight[i] is the relative share of bytes given to initiator i under contention
+  Weighted_fair_arbiter() {}
+  Weighted_fair_arbiter( const std::vector<double>& w ) : weight(w) {}
+
+  const char* kind() const { return "weighted-fair"; }
+
+  void set_n_inits( unsigned int n )
+  {
+    Arbiter::set_n_inits(n);
+    for (unsigned int i = weight.size(); i < n; i++)
+      weight.push_back(1.0);
+    vtime.resize(n, 0.0);
+  }
+
+  unsigned int select()
+  {
+    unsigned int best = 0;
+    for (unsigned int i = 0; i < n_inits(); i++)
+      if (head(i) && (!head(best) || vtime[i] < vtime[best]
+                      || (vtime[i] == vtime[best] && head(i)->seq < head(best)->seq)))
+        best = i;
+    return best;
+  }
+
+  // An initiator returning from idle must not claim the bandwidth it did not use
+  void activate( unsigned int init )
+  {
+    double floor = -1.0;
+    for (unsigned int i = 0; i < n_inits(); i++)
+      if (head(i) && (floor < 0.0 || vtime[i] < floor))
+        floor = vtime[i];
+    if (floor > vtime[init])
+      vtime[init] = floor;
+  }
+
+  void served( unsigned int init, unsigned int bytes )
+  {
+    vtime[init] += bytes / weight[init];
+  }
+
+  std::vector<double> weight;
+  std::vector<double> vtime;  // Bytes served, scaled by weight
+};
+
+
+struct Oldest_first_arbiter: Arbiter
+{
+  const char* kind() const { return "oldest-first"; }
+
+  unsigned int select()
+  {
+    unsigned int best = 0;
+    for (unsigned int i = 0; i < n_inits(); i++)
+      if (head(i) && (!head(best) || head(i)->time < head(best)->time
+                      || (head(i)->time == head(best)->time && head(i)->seq < head(best)->seq)))
+        best = i;
+    return best;
+  }
+};
+
+#endif
@@ -25,6 +25,10 @@ AT Example
 
 This example contains multiple AT initiators and targets and an AT interconnect
 
+The initiators and targets record their transactions in binary in example.bin, which
+tools/trans_decode turns into text. Run with -text to write the text to example.log
+as the simulation goes, for debugging.
+
 */
 
 
@@ -36,6 +40,7 @@ This example contains multiple AT initiators and targets and an AT interconnect
 #include "at_typec_target.h"
 #include "at_typed_target.h"
 #include "at_typee_target.h"
+#include "tlm2_checker_log.h"
 
 
 #define initiator0_t AT_typeA_initiator
@@ -49,6 +54,25 @@ This example contains multiple AT initiators and targets and an AT interconnect
 #define target3_t    AT_typeD_target
 #define target4_t    AT_typeE_target
 
+// Arbitration policy applied to the requests queued for each target in the interconnect
+// (FCFS_arbiter, Round_robin_arbiter, Fixed_priority_arbiter, Weighted_fair_arbiter
+// or Oldest_first_arbiter)
+
+#define arbiter0_t   FCFS_arbiter
+#define arbiter1_t   FCFS_arbiter
+#define arbiter2_t   FCFS_arbiter
+#define arbiter3_t   FCFS_arbiter
+#define arbiter4_t   FCFS_arbiter
+
+// Protocol checker on each socket of the interconnect. With tlm2_base_protocol_checker<32, false>
+// the checkers pass every call straight through, for performance runs. To check only some
+// transactions, call checker_t::set_sample_period(n) or checker_t::add_check_window(start, end)
+// before sc_start. With tlm2_logging_checker<32> every call is only recorded in an event log,
+// opened by tlm2_event_log::instance().open(filename), for checking afterwards with
+// tools/checker_replay
+
+#define checker_t    tlm_utils::tlm2_base_protocol_checker<32, true>
+
 
 SC_MODULE(Top)
 {
@@ -65,16 +89,16 @@ SC_MODULE(Top)
   target3_t    *target3;
   target4_t    *target4;
 
-  tlm_utils::tlm2_base_protocol_checker<> *check_init0;
-  tlm_utils::tlm2_base_protocol_checker<> *check_init1;
-  tlm_utils::tlm2_base_protocol_checker<> *check_init2;
-  tlm_utils::tlm2_base_protocol_checker<> *check_init3;
+  checker_t    *check_init0;
+  checker_t    *check_init1;
+  checker_t    *check_init2;
+  checker_t    *check_init3;
 
-  tlm_utils::tlm2_base_protocol_checker<> *check_targ0;
-  tlm_utils::tlm2_base_protocol_checker<> *check_targ1;
-  tlm_utils::tlm2_base_protocol_checker<> *check_targ2;
-  tlm_utils::tlm2_base_protocol_checker<> *check_targ3;
-  tlm_utils::tlm2_base_protocol_checker<> *check_targ4;
+  checker_t    *check_targ0;
+  checker_t    *check_targ1;
+  checker_t    *check_targ2;
+  checker_t    *check_targ3;
+  checker_t    *check_targ4;
 
 
   SC_CTOR(Top)
@@ -86,22 +110,49 @@ SC_MODULE(Top)
 
     interconnect = new AT_interconnect("interconnect");
 
+    // By default the interconnect selects the target from address bits [15:8].
+    // Call interconnect->map_region(base, size, target, offset) or
+    // interconnect->load_memory_map(filename) here to describe a real memory map instead
+
+    interconnect->set_arbiter(0, new arbiter0_t);
+    interconnect->set_arbiter(1, new arbiter1_t);
+    interconnect->set_arbiter(2, new arbiter2_t);
+    interconnect->set_arbiter(3, new arbiter3_t);
+    interconnect->set_arbiter(4, new arbiter4_t);
+
+    // Targets may have any number of transactions in flight. Call
+    // interconnect->set_max_outstanding(target, n) to limit the window of a target, and
+    // interconnect->set_response_order(init, AT_interconnect::IN_ORDER) to have the responses
+    // to an initiator returned in the order its requests were issued
+
+    // interconnect->set_scheduler(AT_interconnect::SINGLE) runs the interconnect as a single
+    // process rather than one process per socket
+
+    // interconnect->set_link(bus_width, clock_period) times transfers by their data length
+    // over clocked links, instead of adding a fixed 1000 ps to each response
+
+    // interconnect->set_buffered(true) accepts requests and responses into the queues of the
+    // interconnect at once, as the routers of a network on chip do (see noc.h)
+
+    // Per-socket latency and occupancy statistics, written from end_of_simulation
+    interconnect->set_stats_files("interconnect_stats.json", "interconnect_stats.csv");
+
     target0      = new target0_t("target0");
     target1      = new target1_t("target1");
     target2      = new target2_t("target2");
     target3      = new target3_t("target3");
     target4      = new target4_t("target4");
 
-    check_init0  = new tlm_utils::tlm2_base_protocol_checker<>("check_init0");
-    check_init1  = new tlm_utils::tlm2_base_protocol_checker<>("check_init1");
-    check_init2  = new tlm_utils::tlm2_base_protocol_checker<>("check_init2");
-    check_init3  = new tlm_utils::tlm2_base_protocol_checker<>("check_init3");
+    check_init0  = new checker_t("check_init0");
+    check_init1  = new checker_t("check_init1");
+    check_init2  = new checker_t("check_init2");
+    check_init3  = new checker_t("check_init3");
 
-    check_targ0  = new tlm_utils::tlm2_base_protocol_checker<>("check_targ0");
-    check_targ1  = new tlm_utils::tlm2_base_protocol_checker<>("check_targ1");
-    check_targ2  = new tlm_utils::tlm2_base_protocol_checker<>("check_targ2");
-    check_targ3  = new tlm_utils::tlm2_base_protocol_checker<>("check_targ3");
-    check_targ4  = new tlm_utils::tlm2_base_protocol_checker<>("check_targ4");
+    check_targ0  = new checker_t("check_targ0");
+    check_targ1  = new checker_t("check_targ1");
+    check_targ2  = new checker_t("check_targ2");
+    check_targ3  = new checker_t("check_targ3");
+    check_targ4  = new checker_t("check_targ4");
 
     initiator0->socket.bind(check_init0->target_socket);
     check_init0->initiator_socket.bind(interconnect->targ_socket);
@@ -135,7 +186,21 @@ SC_MODULE(Top)
 
 int sc_main(int argc, char* argv[])
 {
+  if (argc < 2 || string(argv[1]) != "-text")
+    trans_log.open("example.bin");
+
   Top top("top");
   sc_start();
+
+  // Run the end_of_simulation callbacks, which write the interconnect statistics
+  sc_stop();
+
+  // Payloads still referenced, when compiled with -DMM_ACCOUNTING
+  MM_ACCOUNT( report(cout) );
+
+  // Show how the bandwidth of each target was shared between the initiators
+  top.interconnect->report_arbitration(cout);
+
+  trans_log.close();
   return 0;
 }
@@ -18,12 +18,29 @@
 //----------------------------------------------------------------------
 
 // Version 1  09-Sep-2008
+// Version 2  16-Oct-2026  Range-table address decoding through Memory_map
+// Version 3  16-Oct-2026  Pluggable arbitration policies for the request queues
+// Version 4  16-Oct-2026  Outstanding request window per target, transaction IDs and
+//                         optional in-order response delivery per initiator
+// Version 5  16-Oct-2026  Optional single scheduler process driven by ready bitmaps
+// Version 6  16-Oct-2026  Per-socket latency and occupancy statistics
+// Version 7  16-Oct-2026  Cache of DMI grants per target
+// Version 8  16-Oct-2026  Clocked link bandwidth model
+// Version 9  16-Oct-2026  Bursts must lie within one region of the memory map
+// Version 10 16-Oct-2026  Buffered mode, for cascading interconnects into a network
+// Version 11 16-Oct-2026  Phases noted for memory manager accounting
 
 
 #ifndef __AT_INTERCONNECT_H__
 #define __AT_INTERCONNECT_H__
 
 #include "common_header.h"
+#include "memory_map.h"
+#include "arbiter.h"
+#include "interconnect_stats.h"
+#include "link_model.h"
+
+#include <map>
 
 struct AT_interconnect: sc_module
 {
@@ -33,6 +50,17 @@ struct AT_interconnect: sc_module
   SC_CTOR(AT_interconnect)
   : targ_socket("targ_socket")
   , init_socket("init_socket")
+  , m_scheduler(PER_SOCKET)
+  , m_scheduling(false)
+  , m_activations(0)
+  , m_requests(0)
+  , m_link_width(0)
+  , m_link_period(SC_ZERO_TIME)
+  , m_buffered(false)
+  , m_dmi_cache_size(16)
+  , m_dmi_hits(0)
+  , m_dmi_misses(0)
+  , m_dmi_evictions(0)
   {
     targ_socket.register_b_transport              (this, &AT_interconnect::b_transport);
     targ_socket.register_nb_transport_fw          (this, &AT_interconnect::nb_transport_fw);
@@ -42,6 +70,152 @@ struct AT_interconnect: sc_module
     init_socket.register_invalidate_direct_mem_ptr(this, &AT_interconnect::invalidate_direct_mem_ptr);
   }
 
+  // System memory map, to be filled in during elaboration. If no regions are added, the
+  // interconnect falls back to using the top bits of the address to select the target
+
+  Memory_map memory_map;
+
+  void map_region( sc_dt::uint64 base, sc_dt::uint64 size, unsigned int target,
+                   sc_dt::uint64 offset = 0 )
+  {
+    memory_map.add_region( base, size, target, offset );
+  }
+
+  void load_memory_map( const char* filename )
+  {
+    if ( !memory_map.load(filename) )
+    {
+      std::string txt = std::string("Cannot open memory map file ") + filename;
+      SC_REPORT_FATAL("AT_interconnect", txt.c_str());
+    }
+  }
+
+  // Select the arbitration policy for the requests queued on one target socket.
+  // Must be called during elaboration. Targets with no arbiter set use FCFS_arbiter
+
+  void set_arbiter( unsigned int target, Arbiter* arb )
+  {
+    if (target >= m_arbiter_cfg.size())
+      m_arbiter_cfg.resize(target + 1, 0);
+    m_arbiter_cfg[target] = arb;
+  }
+
+  Arbiter* get_arbiter( unsigned int target ) { return arbiter[target]; }
+
+  // Pipelined mode. By default the only limit on the number of transactions in flight
+  // to a target is the BEGIN_REQ/END_REQ exclusion rule. set_max_outstanding limits the
+  // number of transactions that have been sent to the target and not yet completed by it
+  // (0 = no limit); further requests wait in the arbiter until the target finishes one.
+
+  void set_max_outstanding( unsigned int target, unsigned int n )
+  {
+    if (target >= m_max_outstanding_cfg.size())
+      m_max_outstanding_cfg.resize(target + 1, 0);
+    m_max_outstanding_cfg[target] = n;
+  }
+
+  // Every request is tagged with a transaction ID, counting from 0 per initiator.
+  // With PASS_THROUGH, responses are returned to the initiator in the order the targets
+  // produce them. With IN_ORDER, a response that overtakes an earlier request of the same
+  // initiator is completed at the target and parked until the earlier responses have gone
+
+  enum response_order_t { PASS_THROUGH, IN_ORDER };
+
+  void set_response_order( unsigned int init, response_order_t order )
+  {
+    if (init >= m_rsp_order_cfg.size())
+      m_rsp_order_cfg.resize(init + 1, PASS_THROUGH);
+    m_rsp_order_cfg[init] = order;
+  }
+
+  unsigned int get_outstanding( unsigned int target ) { return outstanding[target]; }
+
+  // Process structure. PER_SOCKET spawns one method process per target and one per
+  // initiator, each sensitive to its own event. SINGLE uses one method process for the
+  // whole interconnect, which services every socket flagged in the ready bitmaps in a
+  // single activation. Must be called during elaboration
+
+  enum scheduler_t { PER_SOCKET, SINGLE };
+
+  void set_scheduler( scheduler_t kind ) { m_scheduler = kind; }
+
+  // Number of process activations and of requests received, for profiling
+  sc_dt::uint64 get_activations() const { return m_activations; }
+  sc_dt::uint64 get_requests()    const { return m_requests; }
+
+  // Link bandwidth. By default every BEGIN_RESP on the backward path is simply delayed by
+  // 1000 ps. set_link gives every socket a request link towards its target and a response
+  // link towards its initiator, each bus_width bytes wide and clocked at clock_period.
+  // Transfers are then timed by their data length and wait for the link to be free
+
+  void set_link( unsigned int bus_width, const sc_time& clock_period )
+  {
+    m_link_width  = bus_width;
+    m_link_period = clock_period;
+  }
+
+  const Link& get_request_link ( unsigned int target ) const { return req_link[target]; }
+  const Link& get_response_link( unsigned int init )   const { return rsp_link[init]; }
+
+  // Buffered mode. By default END_REQ and END_RESP pass through the interconnect, so an
+  // initiator is held until the target accepts its request, and a target until the initiator
+  // accepts its response. set_buffered(true) has the interconnect take every request and every
+  // response into its own queues at once, like a router with unbounded buffers. Interconnects
+  // cascaded so that routes can form a cycle must be buffered, or they may deadlock
+
+  void set_buffered( bool buffered ) { m_buffered = buffered; }
+
+  // DMI grants returned by each target are cached, so that repeated requests for the same
+  // region are answered without calling the target. An invalidation from a target evicts only
+  // the cached grants of that target that overlap the invalidated range.
+  // set_dmi_cache_size(0) disables the cache
+
+  void set_dmi_cache_size( unsigned int n ) { m_dmi_cache_size = n; }
+
+  sc_dt::uint64 get_dmi_hits()      const { return m_dmi_hits; }
+  sc_dt::uint64 get_dmi_misses()    const { return m_dmi_misses; }
+  sc_dt::uint64 get_dmi_evictions() const { return m_dmi_evictions; }
+
+  // Latency and occupancy statistics, see interconnect_stats.h. If file names are given,
+  // the statistics are written as JSON and/or CSV from end_of_simulation
+
+  Interconnect_stats stats;
+
+  void set_stats_files( const char* json_file, const char* csv_file = 0 )
+  {
+    m_stats_json = json_file ? json_file : "";
+    m_stats_csv  = csv_file  ? csv_file  : "";
+  }
+
+  void write_stats()
+  {
+    if ( !m_stats_json.empty() )
+    {
+      std::ofstream os( m_stats_json.c_str() );
+      stats.write_json( os, name() );
+    }
+    if ( !m_stats_csv.empty() )
+    {
+      std::ofstream os( m_stats_csv.c_str() );
+      stats.write_csv( os, name() );
+    }
+  }
+
+  void end_of_simulation()
+  {
+    write_stats();
+  }
+
+  // Per-initiator grant counts, bytes and waiting times for every target
+  void report_arbitration( std::ostream& os )
+  {
+    for (unsigned int t = 0; t < n_targets; t++)
+    {
+      os << name() << ": target " << t << " (" << arbiter[t]->kind() << ")\n";
+      arbiter[t]->report(os);
+    }
+  }
+
   void end_of_elaboration()
   {
     n_targets       = init_socket.size();
@@ -50,10 +224,69 @@ struct AT_interconnect: sc_module
     rsp_in_progress = new gp_ptr  [n_inits];
     end_req_event   = new sc_event[n_targets];
     end_rsp_event   = new sc_event[n_inits];
-    req_queue       = new std::deque<Trans>[n_targets];
+    arbiter         = new Arbiter*[n_targets];
     rsp_queue       = new std::deque<Trans>[n_inits];
+    outstanding     = new unsigned int[n_targets];
+    max_outstanding = new unsigned int[n_targets];
+    dispatch_pending= new bool[n_targets];
+    next_id         = new sc_dt::uint64[n_inits];
+    next_rsp_id     = new sc_dt::uint64[n_inits];
+    rsp_order       = new response_order_t[n_inits];
+    reorder_buf     = new std::map<sc_dt::uint64, Trans>[n_inits];
+
+    stats.resize( n_targets, n_inits );
+    dmi_cache.resize( n_targets );
+
+    req_link.resize( n_targets );
+    rsp_link.resize( n_inits );
+    for (unsigned int i = 0; i < n_targets; i++)
+      req_link[i].configure( m_link_width, m_link_period );
+    for (unsigned int i = 0; i < n_inits; i++)
+      rsp_link[i].configure( m_link_width, m_link_period );
+
+    for (unsigned int i = 0; i < n_targets; i++)
+    {
+      arbiter[i] = (i < m_arbiter_cfg.size() && m_arbiter_cfg[i]) ? m_arbiter_cfg[i]
+                                                                  : new FCFS_arbiter;
+      arbiter[i]->set_n_inits( n_inits );
+
+      outstanding[i]      = 0;
+      max_outstanding[i]  = i < m_max_outstanding_cfg.size() ? m_max_outstanding_cfg[i] : 0;
+      dispatch_pending[i] = false;
+    }
+
+    for (unsigned int i = 0; i < n_inits; i++)
+    {
+      next_id[i]     = 0;
+      next_rsp_id[i] = 0;
+      rsp_order[i]   = i < m_rsp_order_cfg.size() ? m_rsp_order_cfg[i] : PASS_THROUGH;
+    }
+
+    if ( !memory_map.empty() )
+      memory_map.build( n_targets );
+
+    for (unsigned int i = 0; i < n_targets; i++)
+      req_in_progress[i] = 0;
+    for (unsigned int i = 0; i < n_inits; i++)
+      rsp_in_progress[i] = 0;
+
+    if (m_scheduler == SINGLE)
+    {
+      // One bit per socket, so one activation can find every socket needing service
+      req_ready.assign( (n_targets + 63) / 64, 0 );
+      rsp_ready.assign( (n_inits   + 63) / 64, 0 );
+
+      sc_spawn_options* opt = new sc_spawn_options;
+      opt->spawn_method();
+      opt->dont_initialize();
+      opt->set_sensitivity( &schedule_event );
+
+      sc_spawn(sc_bind(&AT_interconnect::scheduler_process, this), "scheduler_process", opt);
+      return;
+    }
 
-    // Spawn one process per target, to wake up on receiving END_REQ
+    // Spawn one process per target, to wake up on receiving END_REQ, or when a slot
+    // in the outstanding window of the target is freed
 
     for (unsigned int i = 0; i < n_targets; i++)
     {
@@ -64,9 +297,7 @@ struct AT_interconnect: sc_module
 
       ostringstream oss;
       oss << "end_req_process" << i;
-      sc_spawn(sc_bind(&AT_interconnect::end_req_process, this, i), oss.str().c_str(), opt);
-
-      req_in_progress[i] = 0;
+      sc_spawn(sc_bind(&AT_interconnect::end_req_method, this, i), oss.str().c_str(), opt);
     }
 
     // Spawn one process per initiator, to wake up on receiving END_RESP
@@ -80,9 +311,7 @@ struct AT_interconnect: sc_module
 
       ostringstream oss;
       oss << "end_rsp_process" << i;
-      sc_spawn(sc_bind(&AT_interconnect::end_rsp_process, this, i), oss.str().c_str(), opt);
-
-      rsp_in_progress[i] = 0;
+      sc_spawn(sc_bind(&AT_interconnect::end_rsp_method, this, i), oss.str().c_str(), opt);
     }
   }
 
@@ -90,8 +319,13 @@ struct AT_interconnect: sc_module
 
   virtual void b_transport( int id, tlm::tlm_generic_payload& trans, sc_time& delay )
   {
+    unsigned int  target;
     sc_dt::uint64 masked_address;
-    unsigned int target = decode_address( trans.get_address(), masked_address );
+    if ( !decode_address( trans.get_address(), target, masked_address, burst_span(trans) ) )
+    {
+      trans.set_response_status( tlm::TLM_ADDRESS_ERROR_RESPONSE );
+      return;
+    }
     trans.set_address( masked_address );
 
     init_socket[target]->b_transport( trans, delay );
@@ -101,6 +335,8 @@ struct AT_interconnect: sc_module
   virtual tlm::tlm_sync_enum nb_transport_fw( int id, tlm::tlm_generic_payload& trans,
                                               tlm::tlm_phase& phase, sc_time& delay )
   {
+    MM_ACCOUNT( note_phase(trans, phase) );
+
     unsigned int target;
 
     // Sticky extension, survives the transaction pool
@@ -108,11 +344,17 @@ struct AT_interconnect: sc_module
     accessor(trans).get_extension(ext);
 
     bool is_request = (phase == tlm::BEGIN_REQ);
+    bool is_end_rsp = (phase == tlm::END_RESP);
 
     if (phase == tlm::BEGIN_REQ)
     {
       sc_dt::uint64 masked_address;
-      target = decode_address( trans.get_address(), masked_address );
+      if ( !decode_address( trans.get_address(), target, masked_address, burst_span(trans) ) )
+      {
+        // Unmapped address: complete the transaction immediately with an error response
+        trans.set_response_status( tlm::TLM_ADDRESS_ERROR_RESPONSE );
+        return tlm::TLM_COMPLETED;
+      }
       trans.set_address( masked_address );
 
       if (!ext)
@@ -122,20 +364,34 @@ struct AT_interconnect: sc_module
       }
       ext->init   = id;
       ext->target = target;
+      ext->id     = next_id[id]++;
+      m_requests++;
       ext->dont_propagate_fw = false;
+      ext->end_req_sent = false;
+      ext->t_begin = sc_time_stamp() + delay;
+
+      Socket_stats& ts = stats.target[target];
+      ts.transactions++;
+      ts.bytes += trans.get_data_length();
 
-      if (req_in_progress[target])
+      if ( target_busy(target) )
       {
         // Queue the request to be sent forward later
         trans.acquire();
-        Trans req;
-        req.trans = &trans;
-        req.time  = sc_time_stamp() + delay;
-        req_queue[target].push_back( req );
+        arbiter[target]->push( &trans, sc_time_stamp() + delay, id );
+        ts.queue.set( arbiter[target]->size() );
 
-        return tlm::TLM_ACCEPTED;
+        return accept_request( trans, phase );
       }
       req_in_progress[target] = &trans;
+      outstanding[target]++;
+      arbiter[target]->granted( &trans, sc_time_stamp() + delay, id );
+
+      ext->t_issue = ext->t_begin;
+      ts.queue_delay.record( 0 );
+      ts.in_flight.set( outstanding[target] );
+
+      request_link( target, trans, delay );
     }
     else if (phase == tlm::END_RESP)
     {
@@ -144,7 +400,7 @@ struct AT_interconnect: sc_module
       target = ext->target;
 
       assert( rsp_in_progress[ext->init] );
-      end_rsp_event[ext->init].notify();
+      notify_end_rsp( ext->init );
 
       if (ext->dont_propagate_fw)
         return tlm::TLM_ACCEPTED;
@@ -158,18 +414,33 @@ struct AT_interconnect: sc_module
       if ((phase == tlm::END_REQ) || (phase == tlm::BEGIN_RESP))
       {
         assert( req_in_progress[target] );
-        end_req_event[target].notify();
+        notify_end_req( target );
       }
+      if (phase == tlm::END_REQ)
+        ext->end_req_sent = true;
 
       // Need to check response exclusion rule here before passing BEGIN_RESP on return path!
       if (phase == tlm::BEGIN_RESP)
       {
+        if ( hold_response( id, &trans, delay ) )
+        {
+          // Finish with the target now and only accept the request on the initiator side
+          end_resp_at_target( target, trans );
+          phase = tlm::END_REQ;
+          return tlm::TLM_UPDATED;
+        }
+
         if (rsp_in_progress[id])
         {
           queue_the_rsp_to_be_sent_bw_later( id, &trans, delay );
-          return tlm::TLM_ACCEPTED;
+          response_committed( id, &trans );
+          buffer_response( target, trans );
+          return accept_request( trans, phase );
         }
         rsp_in_progress[id] = &trans;
+        response_link( id, trans, delay );
+        response_committed( id, &trans );
+        buffer_response( target, trans );
       }
     }
     else if (status == tlm::TLM_COMPLETED)
@@ -177,20 +448,35 @@ struct AT_interconnect: sc_module
       // Incoming phase could have been BEGIN_REQ or END_RESP
       if ( is_request )
       {
-        end_req_event[target].notify();
+        notify_end_req( target );
+        target_done( target, &trans );
 
         // Once target has returned TLM_COMPLETED, do not propagate transaction forward again
         ext->dont_propagate_fw = true;
 
+        if ( hold_response( id, &trans, delay ) )
+        {
+          phase = tlm::END_REQ;
+          return tlm::TLM_UPDATED;
+        }
+
         // Need to check response exclusion rule here before passing BEGIN_RESP on return path!
         if (rsp_in_progress[id])
         {
           queue_the_rsp_to_be_sent_bw_later( id, &trans, delay );
-          return tlm::TLM_ACCEPTED;
+          response_committed( id, &trans );
+          return accept_request( trans, phase );
         }
+        response_link( id, trans, delay );
+        response_committed( id, &trans );
       }
       // Cannot expect an END_RESP from the initiator after returning TLM_COMPLETED
     }
+    else if (is_request)
+      return accept_request( trans, phase );
+
+    if (is_end_rsp)
+      target_done( target, &trans );
 
     return status;
   }
@@ -198,22 +484,55 @@ struct AT_interconnect: sc_module
   virtual bool get_direct_mem_ptr( int id, tlm::tlm_generic_payload& trans,
                                            tlm::tlm_dmi& dmi_data)
   {
+    const Memory_region* region = memory_map.empty() ? 0 : memory_map.decode( trans.get_address() );
+
+    sc_dt::uint64 address = trans.get_address();
+
+    unsigned int  target;
     sc_dt::uint64 masked_address;
-    unsigned int target = decode_address( trans.get_address(), masked_address );
+    if ( !decode_address( address, target, masked_address ) )
+      return false;
     trans.set_address( masked_address );
 
+    if ( lookup_dmi( target, address, trans.get_command(), dmi_data ) )
+    {
+      m_dmi_hits++;
+      return true;
+    }
+    m_dmi_misses++;
+
     bool status = init_socket[target]->get_direct_mem_ptr( trans, dmi_data );
 
-    dmi_data.set_start_address( reconstruct_address(dmi_data.get_start_address(), target) );
-    dmi_data.set_end_address(   reconstruct_address(dmi_data.get_end_address(), target) );
+    sc_dt::uint64 local_start = dmi_data.get_start_address();
+    sc_dt::uint64 local_end   = dmi_data.get_end_address();
+    sc_dt::uint64 start = local_start;
+    sc_dt::uint64 end   = local_end;
+    reconstruct_range( target, region, start, end );
+
+    // If the range was clipped to the region, the pointer must move with its start
+    if (status && region && local_start < region->offset)
+    {
+      dmi_data.set_dmi_ptr( dmi_data.get_dmi_ptr() + (region->offset - local_start) );
+      local_start = region->offset;
+    }
+    if (region && local_end > region->local_last())
+      local_end = region->local_last();
+
+    dmi_data.set_start_address( start );
+    dmi_data.set_end_address( end );
+
+    if (status)
+      insert_dmi( target, dmi_data, local_start, local_end );
 
     return status;
   }
 
   virtual unsigned int transport_dbg( int id, tlm::tlm_generic_payload& trans )
   {
+    unsigned int  target;
     sc_dt::uint64 masked_address;
-    unsigned int target = decode_address( trans.get_address(), masked_address );
+    if ( !decode_address( trans.get_address(), target, masked_address ) )
+      return 0;
     trans.set_address( masked_address );
 
     return init_socket[target]->transport_dbg( trans );
@@ -225,10 +544,12 @@ struct AT_interconnect: sc_module
   virtual tlm::tlm_sync_enum nb_transport_bw( int id, tlm::tlm_generic_payload& trans,
                                               tlm::tlm_phase& phase, sc_time& delay )
   {
+    MM_ACCOUNT( note_phase(trans, phase) );
+
     if (phase == tlm::END_REQ || (&trans == req_in_progress[id] && phase == tlm::BEGIN_RESP))
     {
       assert( req_in_progress[id] );
-      end_req_event[id].notify();
+      notify_end_req( id );
     }
 
     route_extension* ext;
@@ -237,18 +558,43 @@ struct AT_interconnect: sc_module
 
     int init   = ext->init;
 
+    // The initiator has had its END_REQ from the interconnect already
+    if (phase == tlm::END_REQ && ext->end_req_sent)
+      return tlm::TLM_ACCEPTED;
+
+    bool is_response = (phase == tlm::BEGIN_RESP);
+
     if (phase == tlm::BEGIN_RESP)
     {
+      if ( hold_response( init, &trans, delay ) )
+      {
+        // Complete the transaction at the target; the response is parked in the interconnect
+        target_done( id, &trans );
+        return tlm::TLM_COMPLETED;
+      }
+
       if (rsp_in_progress[init])
       {
         queue_the_rsp_to_be_sent_bw_later( init, &trans, delay );
+        response_committed( init, &trans );
+        if (m_buffered)
+        {
+          ext->dont_propagate_fw = true;
+          target_done( id, &trans );
+          return tlm::TLM_COMPLETED;
+        }
         return tlm::TLM_ACCEPTED;
       }
 
       rsp_in_progress[init] = &trans;
+      if (m_buffered)
+        ext->dont_propagate_fw = true;
 
-      // Set the delay so there are multiple responses pending
-      delay = delay + sc_time(1000, SC_PS);
+      if ( rsp_link[init].enabled() )
+        response_link( init, trans, delay );
+      else
+        // Set the delay so there are multiple responses pending
+        delay = delay + sc_time(1000, SC_PS);
     }
 
     tlm::tlm_sync_enum status;
@@ -258,9 +604,20 @@ struct AT_interconnect: sc_module
     {
       assert( phase == tlm::BEGIN_RESP );
       assert( rsp_in_progress[init] );
-      end_rsp_event[init].notify();
+      notify_end_rsp( init );
+      if (!m_buffered)
+        target_done( id, &trans );
     }
 
+    if (is_response)
+      response_committed( init, &trans );
+
+    if (is_response && m_buffered)
+    {
+      // The response is now the responsibility of the interconnect
+      target_done( id, &trans );
+      return tlm::TLM_COMPLETED;
+    }
     return status;
   }
 
@@ -268,35 +625,152 @@ struct AT_interconnect: sc_module
   virtual void invalidate_direct_mem_ptr( int id, sc_dt::uint64 start_range,
                                                   sc_dt::uint64 end_range )
   {
-    // Reconstruct address range in system memory map
-    sc_dt::uint64 bw_start_range = reconstruct_address(start_range, id);
-    sc_dt::uint64 bw_end_range   = reconstruct_address(end_range, id);
+    evict_dmi( id, start_range, end_range );
+
+    if ( memory_map.empty() )
+    {
+      // Reconstruct address range in system memory map
+      sc_dt::uint64 bw_start_range = reconstruct_address(start_range, id);
+      sc_dt::uint64 bw_end_range   = reconstruct_address(end_range, id);
+
+      // Propagate call backward to all initiators
+      for (unsigned int i = 0; i < targ_socket.size(); i++)
+        targ_socket[i]->invalidate_direct_mem_ptr(bw_start_range, bw_end_range);
+      return;
+    }
+
+    // The target range may be visible through several regions of the memory map
+    const std::vector<unsigned int>& regions = memory_map.regions_of(id);
+    for (unsigned int r = 0; r < regions.size(); r++)
+    {
+      const Memory_region& region = memory_map.region( regions[r] );
+      if (end_range < region.offset || start_range > region.local_last())
+        continue;
+
+      sc_dt::uint64 bw_start_range = start_range;
+      sc_dt::uint64 bw_end_range   = end_range;
+      reconstruct_range( id, &region, bw_start_range, bw_end_range );
 
-    // Propagate call backward to all initiators
-    for (unsigned int i = 0; i < targ_socket.size(); i++)
-      targ_socket[i]->invalidate_direct_mem_ptr(bw_start_range, bw_end_range);
+      for (unsigned int i = 0; i < targ_socket.size(); i++)
+        targ_socket[i]->invalidate_direct_mem_ptr(bw_start_range, bw_end_range);
+    }
   }
 
 
 private:
 
+  // Wake the process that services a target after END_REQ, or an initiator after END_RESP
+
+  void notify_end_req( unsigned int target )
+  {
+    if (m_scheduler == PER_SOCKET)
+    {
+      end_req_event[target].notify();
+      return;
+    }
+    req_ready[target / 64] |= sc_dt::uint64(1) << (target % 64);
+    if (!m_scheduling)
+      schedule_event.notify();
+  }
+
+  void notify_end_rsp( unsigned int init )
+  {
+    if (m_scheduler == PER_SOCKET)
+    {
+      end_rsp_event[init].notify();
+      return;
+    }
+    rsp_ready[init / 64] |= sc_dt::uint64(1) << (init % 64);
+    if (!m_scheduling)
+      schedule_event.notify();
+  }
+
+  void end_req_method( unsigned int target )
+  {
+    m_activations++;
+    end_req_process( target );
+  }
+
+  void end_rsp_method( unsigned int init )
+  {
+    m_activations++;
+    end_rsp_process( init );
+  }
+
+  void record_response( unsigned int init, tlm::tlm_generic_payload* trans )
+  {
+    route_extension* ext;
+    accessor(*trans).get_extension(ext);
+    assert(ext);
+
+    Socket_stats& is = stats.init[init];
+    is.transactions++;
+    is.bytes += trans->get_data_length();
+    is.service_time.record( Interconnect_stats::ps_since(ext->t_begin) );
+  }
+
+  // SINGLE scheduler. Services ready targets, then ready initiators, and repeats until no
+  // socket is left ready, so sockets flagged while servicing others are not missed
+  void scheduler_process()
+  {
+    m_activations++;
+    m_scheduling = true;
+
+    bool busy = true;
+    while (busy)
+    {
+      busy = false;
+      for (unsigned int w = 0; w < req_ready.size(); w++)
+        while (req_ready[w])
+        {
+          unsigned int bit = lowest_bit( req_ready[w] );
+          req_ready[w] &= req_ready[w] - 1;
+          end_req_process( w * 64 + bit );
+          busy = true;
+        }
+      for (unsigned int w = 0; w < rsp_ready.size(); w++)
+        while (rsp_ready[w])
+        {
+          unsigned int bit = lowest_bit( rsp_ready[w] );
+          rsp_ready[w] &= rsp_ready[w] - 1;
+          end_rsp_process( w * 64 + bit );
+          busy = true;
+        }
+    }
+
+    m_scheduling = false;
+  }
+
+  static unsigned int lowest_bit( sc_dt::uint64 word )
+  {
+#ifdef __GNUC__
+    return __builtin_ctzll( word );
+#else
+    unsigned int bit = 0;
+    while (!(word & 1))
+    {
+      word >>= 1;
+      bit++;
+    }
+    return bit;
+#endif
+  }
+
   void end_req_process( unsigned int target )
   {
-    // Called whenever END_REQ is received from a target
-    assert( req_in_progress[target] );
+    // Called whenever END_REQ is received from a target, or when the target has completed
+    // a transaction while its outstanding window was full
+    assert( req_in_progress[target] || dispatch_pending[target] );
+    dispatch_pending[target] = false;
 
-    if ( req_queue[target].empty() )
+    if ( arbiter[target]->empty() || window_full(target) )
     {
       req_in_progress[target] = 0;
     }
     else
     {
-      // Requests are serviced in a first-come-first-served order
-      // You would re-write this to implement the arbitration strategy of
-      // your particular interconnect component.
-
-      Trans req = req_queue[target].front();
-      req_queue[target].pop_front();
+      // The arbitration policy of the target socket selects the next request
+      Arbiter::Request req = arbiter[target]->pop();
 
       gp_ptr         trans = req.trans;
       tlm::tlm_phase phase = tlm::BEGIN_REQ;
@@ -308,6 +782,7 @@ private:
         delay = req.time - sc_time_stamp();
 
       req_in_progress[target] = trans;
+      outstanding[target]++;
 
       route_extension* ext;
       accessor(*trans).get_extension(ext);
@@ -315,6 +790,14 @@ private:
       assert( ext->target == int(target) );
       int init = ext->init;
 
+      Socket_stats& ts = stats.target[target];
+      ts.queue.set( arbiter[target]->size() );
+      ts.in_flight.set( outstanding[target] );
+      ts.queue_delay.record( Interconnect_stats::ps_since(req.time) );
+      ext->t_issue = sc_time_stamp() + delay;
+
+      request_link( target, *trans, delay );
+
       tlm::tlm_sync_enum status;
       status = init_socket[target]->nb_transport_fw( *trans, phase, delay );
 
@@ -323,22 +806,38 @@ private:
         if ((phase == tlm::END_REQ) || (phase == tlm::BEGIN_RESP))
         {
           assert( req_in_progress[target] );
-          end_req_event[target].notify();
+          notify_end_req( target );
         }
 
         // Need to check response exclusion rule
         if (phase == tlm::BEGIN_RESP)
         {
-          if (rsp_in_progress[init])
+          if ( hold_response( init, trans, delay ) )
+          {
+            end_resp_at_target( target, *trans );
+            phase = tlm::END_REQ;
+          }
+          else if (rsp_in_progress[init])
           {
             queue_the_rsp_to_be_sent_bw_later( init, trans, delay );
+            response_committed( init, trans );
+            buffer_response( target, *trans );
+            trans->release();
             return;
           }
-          rsp_in_progress[init] = trans;
+          else
+          {
+            rsp_in_progress[init] = trans;
+            buffer_response( target, *trans );
+          }
         }
+        bool is_response = (phase == tlm::BEGIN_RESP);
 
         // Need to propagate transaction to initiator on backward path
         send_bw_to_initiator( trans, phase, delay);
+
+        if (is_response)
+          response_committed( init, trans );
       }
       else if (status == tlm::TLM_COMPLETED)
       {
@@ -347,7 +846,8 @@ private:
         // the target immediately returns TLM_COMPLETED. This suggests a weird target!
 
         assert( req_in_progress[target] );
-        end_req_event[target].notify();
+        notify_end_req( target );
+        target_done( target, trans );
 
         // Once target has returned TLM_COMPLETED, do not propagate transaction forward again
         ext->dont_propagate_fw = true;
@@ -355,16 +855,25 @@ private:
         // Need to propagate response to initiator on backward path
         phase = tlm::BEGIN_RESP;
 
-        // Need to check response exclusion rule
-        if (rsp_in_progress[init])
+        if ( hold_response( init, trans, delay ) )
+        {
+          // Only the END_REQ can be passed on for now
+          phase = tlm::END_REQ;
+          send_bw_to_initiator( trans, phase, delay);
+        }
+        else if (rsp_in_progress[init])
         {
           queue_the_rsp_to_be_sent_bw_later( init, trans, delay );
-          return;
+          response_committed( init, trans );
         }
-        rsp_in_progress[init] = trans;
+        else
+        {
+          rsp_in_progress[init] = trans;
 
-        // Need to propagate transaction to initiator on backward path
-        send_bw_to_initiator( trans, phase, delay);
+          // Need to propagate transaction to initiator on backward path
+          send_bw_to_initiator( trans, phase, delay);
+          response_committed( init, trans );
+        }
       }
 
       // Finally finished with the delayed request transaction
@@ -379,6 +888,8 @@ private:
     rsp.trans = trans;
     rsp.time  = sc_time_stamp() + delay;
     rsp_queue[init].push_back( rsp );
+
+    stats.init[init].queue.set( rsp_queue[init].size() );
   }
 
   void end_rsp_process( unsigned int init )
@@ -395,6 +906,10 @@ private:
       Trans rsp = rsp_queue[init].front();
       rsp_queue[init].pop_front();
 
+      Socket_stats& is = stats.init[init];
+      is.queue.set( rsp_queue[init].size() );
+      is.queue_delay.record( Interconnect_stats::ps_since(rsp.time) );
+
       gp_ptr         trans = rsp.trans;
       tlm::tlm_phase phase = tlm::BEGIN_RESP;
       sc_time        delay;
@@ -425,6 +940,17 @@ private:
     int init   = ext->init;
     int target = ext->target;
 
+    // In buffered mode the initiator may have had its END_REQ when the request was queued
+    if (phase == tlm::END_REQ)
+    {
+      if (ext->end_req_sent)
+        return;
+      ext->end_req_sent = true;
+    }
+
+    if (phase == tlm::BEGIN_RESP)
+      response_link( init, *trans, delay );
+
     tlm::tlm_sync_enum status = targ_socket[init]->nb_transport_bw( *trans, phase, delay );
 
     if (status == tlm::TLM_UPDATED || status == tlm::TLM_COMPLETED)
@@ -433,7 +959,7 @@ private:
       // TLM_UPDATED only makes sense when an extended phase will be sent later
 
       assert( rsp_in_progress[init] );
-      end_rsp_event[init].notify();
+      notify_end_rsp( init );
 
       if (ext->dont_propagate_fw)
         return;
@@ -444,20 +970,254 @@ private:
       status = init_socket[target]->nb_transport_fw( *trans, phase, delay );
       assert( status != tlm::TLM_UPDATED );
       // Ignore return value
+
+      target_done( target, trans );
+    }
+  }
+
+  // Link helpers. A request carries the write data to the target, a response carries the
+  // read data back to the initiator
+
+  void request_link( unsigned int target, tlm::tlm_generic_payload& trans, sc_time& delay )
+  {
+    if ( req_link[target].enabled() )
+      req_link[target].transfer( trans.is_write() ? trans.get_data_length() : 0, delay );
+  }
+
+  void response_link( unsigned int init, tlm::tlm_generic_payload& trans, sc_time& delay )
+  {
+    if ( rsp_link[init].enabled() )
+      rsp_link[init].transfer( trans.is_read() ? trans.get_data_length() : 0, delay );
+  }
+
+  // DMI cache helpers. Entries hold the grant as returned to initiators, in system addresses,
+  // together with the range as seen by the target so invalidations can be matched exactly
+
+  bool lookup_dmi( unsigned int target, sc_dt::uint64 address, tlm::tlm_command cmd,
+                   tlm::tlm_dmi& dmi_data )
+  {
+    std::vector<Dmi_entry>& cache = dmi_cache[target];
+    for (unsigned int i = 0; i < cache.size(); i++)
+    {
+      const tlm::tlm_dmi& dmi = cache[i].dmi;
+      if (address < dmi.get_start_address() || address > dmi.get_end_address())
+        continue;
+      if ((cmd == tlm::TLM_READ_COMMAND  && !dmi.is_read_allowed()) ||
+          (cmd == tlm::TLM_WRITE_COMMAND && !dmi.is_write_allowed()))
+        continue;
+
+      dmi_data = dmi;
+      return true;
+    }
+    return false;
+  }
+
+  void insert_dmi( unsigned int target, const tlm::tlm_dmi& dmi_data,
+                   sc_dt::uint64 local_start, sc_dt::uint64 local_end )
+  {
+    if (m_dmi_cache_size == 0)
+      return;
+
+    // A new grant supersedes any cached grant it overlaps
+    std::vector<Dmi_entry>& cache = dmi_cache[target];
+    for (unsigned int i = 0; i < cache.size(); )
+    {
+      if (cache[i].local_end < local_start || cache[i].local_start > local_end)
+        i++;
+      else
+        cache.erase( cache.begin() + i );
+    }
+    if (cache.size() >= m_dmi_cache_size)
+      cache.erase( cache.begin() );
+
+    Dmi_entry entry;
+    entry.dmi         = dmi_data;
+    entry.local_start = local_start;
+    entry.local_end   = local_end;
+    cache.push_back( entry );
+  }
+
+  void evict_dmi( unsigned int target, sc_dt::uint64 start_range, sc_dt::uint64 end_range )
+  {
+    std::vector<Dmi_entry>& cache = dmi_cache[target];
+    for (unsigned int i = 0; i < cache.size(); )
+    {
+      if (cache[i].local_end < start_range || cache[i].local_start > end_range)
+        i++;
+      else
+      {
+        cache.erase( cache.begin() + i );
+        m_dmi_evictions++;
+      }
+    }
+  }
+
+  // Pipelined mode helpers
+
+  bool window_full( unsigned int target )
+  {
+    return max_outstanding[target] && outstanding[target] >= max_outstanding[target];
+  }
+
+  bool target_busy( unsigned int target )
+  {
+    return req_in_progress[target] || dispatch_pending[target] || window_full(target);
+  }
+
+  // Called once the target has finished with a transaction, that is, after END_RESP has been
+  // sent to it or it has returned TLM_COMPLETED. Wakes end_req_process if requests were
+  // waiting for a slot in the outstanding window
+  void target_done( unsigned int target, tlm::tlm_generic_payload* trans )
+  {
+    assert( outstanding[target] > 0 );
+    outstanding[target]--;
+
+    route_extension* ext;
+    accessor(*trans).get_extension(ext);
+    assert(ext);
+    stats.target[target].in_flight.set( outstanding[target] );
+    stats.target[target].service_time.record( Interconnect_stats::ps_since(ext->t_issue) );
+
+    if ( !req_in_progress[target] && !dispatch_pending[target] && !arbiter[target]->empty()
+         && !window_full(target) )
+    {
+      dispatch_pending[target] = true;
+      notify_end_req( target );
+    }
+  }
+
+  // Send END_RESP to the target for a response that has been parked by hold_response
+  void end_resp_at_target( unsigned int target, tlm::tlm_generic_payload& trans )
+  {
+    tlm::tlm_phase phase = tlm::END_RESP;
+    sc_time        delay = SC_ZERO_TIME;
+
+    tlm::tlm_sync_enum status = init_socket[target]->nb_transport_fw( trans, phase, delay );
+    assert( status != tlm::TLM_UPDATED );
+    // Ignore return value
+
+    target_done( target, &trans );
+  }
+
+  // Reply to a BEGIN_REQ that the interconnect has taken but cannot answer yet. In buffered
+  // mode the request is accepted at once, otherwise END_REQ follows from the target
+  tlm::tlm_sync_enum accept_request( tlm::tlm_generic_payload& trans, tlm::tlm_phase& phase )
+  {
+    if (!m_buffered)
+      return tlm::TLM_ACCEPTED;
+
+    route_extension* ext;
+    accessor(trans).get_extension(ext);
+    assert(ext);
+    ext->end_req_sent = true;
+    phase = tlm::END_REQ;
+    return tlm::TLM_UPDATED;
+  }
+
+  // In buffered mode, finish a response at the target as soon as the interconnect has taken it
+  void buffer_response( unsigned int target, tlm::tlm_generic_payload& trans )
+  {
+    if (!m_buffered)
+      return;
+
+    route_extension* ext;
+    accessor(trans).get_extension(ext);
+    assert(ext);
+    ext->dont_propagate_fw = true;
+    end_resp_at_target( target, trans );
+  }
+
+  // In IN_ORDER mode, park a response that has overtaken an earlier request of the same
+  // initiator. Returns false if the response can be passed on now. The caller must finish
+  // the transaction at the target, since the END_RESP from the initiator is not forwarded
+  bool hold_response( unsigned int init, tlm::tlm_generic_payload* trans, const sc_time& delay )
+  {
+    if (rsp_order[init] != IN_ORDER)
+      return false;
+
+    route_extension* ext;
+    accessor(*trans).get_extension(ext);
+    assert(ext);
+    if (ext->id == next_rsp_id[init])
+      return false;
+
+    trans->acquire();
+    Trans rsp;
+    rsp.trans = trans;
+    rsp.time  = sc_time_stamp() + delay;
+    reorder_buf[init][ext->id] = rsp;
+    stats.init[init].in_flight.set( reorder_buf[init].size() );
+
+    ext->dont_propagate_fw = true;
+    return true;
+  }
+
+  // Called after a response has been passed on to the initiator or queued behind
+  // rsp_in_progress. Moves any parked responses that are now in order into rsp_queue
+  void response_committed( unsigned int init, tlm::tlm_generic_payload* trans )
+  {
+    record_response( init, trans );
+
+    if (rsp_order[init] != IN_ORDER)
+      return;
+
+    next_rsp_id[init]++;
+
+    std::map<sc_dt::uint64, Trans>& buf = reorder_buf[init];
+    while ( !buf.empty() && buf.begin()->first == next_rsp_id[init] )
+    {
+      // The reference taken by hold_response passes to rsp_queue
+      rsp_queue[init].push_back( buf.begin()->second );
+      record_response( init, buf.begin()->second.trans );
+      buf.erase( buf.begin() );
+      next_rsp_id[init]++;
+
+      stats.init[init].queue.set( rsp_queue[init].size() );
+      stats.init[init].in_flight.set( buf.size() );
+
+      if ( !rsp_in_progress[init] )
+      {
+        // No response in flight, so have end_rsp_process send this one
+        rsp_in_progress[init] = rsp_queue[init].front().trans;
+        notify_end_rsp( init );
+      }
     }
   }
 
-  unsigned int decode_address( sc_dt::uint64 address, sc_dt::uint64& masked_address )
+  // Number of consecutive addresses touched by a transaction
+  static unsigned int burst_span( const tlm::tlm_generic_payload& trans )
+  {
+    unsigned int len = trans.get_data_length();
+    unsigned int wid = trans.get_streaming_width();
+    return (wid && wid < len) ? wid : len;
+  }
+
+  bool decode_address( sc_dt::uint64 address, unsigned int& target, sc_dt::uint64& masked_address,
+                       unsigned int span = 1 )
   {
-    // You would re-write this function to implement the particular routing strategy
-    // of your interconnect component.
+    if ( !memory_map.empty() )
+    {
+      // Binary search of the range table built at end_of_elaboration
+      const Memory_region* region = memory_map.decode( address );
+      if (!region)
+        return false;
+
+      // A burst must not run off the end of its region
+      if (span > 1 && span - 1 > region->last() - address)
+        return false;
+
+      target         = region->target;
+      masked_address = region->to_local( address );
+      return true;
+    }
 
-    // Use the top bits of the address to indicate target
+    // No memory map given, so use the top bits of the address to indicate target
     masked_address = address & 0xff;
-    unsigned int target = (unsigned int)(address >> 8);
+    target = (unsigned int)(address >> 8);
 
     // If address is too big, just wrap around the target number
-    return target % n_targets;
+    target = target % n_targets;
+    return true;
   }
 
   sc_dt::uint64 reconstruct_address ( uint64 address, unsigned int target )
@@ -465,6 +1225,25 @@ private:
     return address | (target << 8);
   }
 
+  // Translate a target-relative address range back into the system memory map,
+  // clipping it to the region through which the target was reached
+  void reconstruct_range( unsigned int target, const Memory_region* region,
+                          sc_dt::uint64& start, sc_dt::uint64& end )
+  {
+    if (!region)
+    {
+      start = reconstruct_address(start, target);
+      end   = reconstruct_address(end, target);
+      return;
+    }
+
+    if (start < region->offset)      start = region->offset;
+    if (end   > region->local_last()) end   = region->local_last();
+
+    start = region->to_global(start);
+    end   = region->to_global(end);
+  }
+
 
 private:
 
@@ -479,7 +1258,11 @@ private:
   {
     int init;
     int target;
+    sc_dt::uint64 id;  // Transaction ID, in order of BEGIN_REQ per initiator
+    sc_time t_begin;   // Time of BEGIN_REQ from the initiator
+    sc_time t_issue;   // Time of BEGIN_REQ to the target
     bool dont_propagate_fw;
+    bool end_req_sent; // END_REQ has been passed to the initiator
   };
 
   tlm_utils::instance_specific_extension_accessor accessor;
@@ -491,14 +1274,65 @@ private:
   sc_event*   end_req_event;
   sc_event*   end_rsp_event;
 
+  // SINGLE scheduler: one bit per target and per initiator waiting to be serviced
+
+  scheduler_t                m_scheduler;
+  bool                       m_scheduling;
+  sc_event                   schedule_event;
+  std::vector<sc_dt::uint64> req_ready;
+  std::vector<sc_dt::uint64> rsp_ready;
+  sc_dt::uint64              m_activations;
+  sc_dt::uint64              m_requests;
+
   struct Trans
   {
     gp_ptr  trans;
     sc_time time;
   };
 
-  std::deque<Trans>* req_queue;
+  Arbiter**          arbiter;
   std::deque<Trans>* rsp_queue;
+
+  // Outstanding request window per target, and response reordering per initiator
+
+  unsigned int*      outstanding;
+  unsigned int*      max_outstanding;
+  bool*              dispatch_pending;
+  sc_dt::uint64*     next_id;
+  sc_dt::uint64*     next_rsp_id;
+  response_order_t*  rsp_order;
+  std::map<sc_dt::uint64, Trans>* reorder_buf;
+
+  std::vector<Arbiter*>         m_arbiter_cfg;
+  std::vector<unsigned int>     m_max_outstanding_cfg;
+  std::vector<response_order_t> m_rsp_order_cfg;
+
+  std::string m_stats_json;
+  std::string m_stats_csv;
+
+  // Request link per target and response link per initiator
+
+  unsigned int      m_link_width;
+  sc_time           m_link_period;
+  std::vector<Link> req_link;
+  std::vector<Link> rsp_link;
+
+  bool              m_buffered;
+
+  // Cached DMI grants per target
+
+  struct Dmi_entry
+  {
+    tlm::tlm_dmi  dmi;
+    sc_dt::uint64 local_start;
+    sc_dt::uint64 local_end;
+  };
+
+  std::vector< std::vector<Dmi_entry> > dmi_cache;
+  unsigned int  m_dmi_cache_size;
+  sc_dt::uint64 m_dmi_hits;
+  sc_dt::uint64 m_dmi_misses;
+  sc_dt::uint64 m_dmi_evictions;
 };
 
 #endif
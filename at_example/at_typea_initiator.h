@@ -18,6 +18,9 @@
 //----------------------------------------------------------------------
 
 // Version 1  09-Sep-2008
+// Version 2  16-Oct-2026  Data storage owned by the payload
+// Version 3  16-Oct-2026  Transactions recorded in the transaction log
+// Version 4  16-Oct-2026  Random numbers from a stream of its own
 
 
 #ifndef __AT_TYPEA_INITIATOR_H__
@@ -36,6 +39,7 @@ struct AT_typeA_initiator: sc_module
   : socket("socket")  // Construct and name socket
   , req_in_progress(0)
   , m_peq(this, &AT_typeA_initiator::peq_cb)
+  , m_random(name())
   {
     socket.register_nb_transport_bw(this, &AT_typeA_initiator::nb_transport_bw);
 
@@ -51,18 +55,21 @@ struct AT_typeA_initiator: sc_module
     // Generate a sequence of random transactions
     for (int i = 0; i < 1000; i++)
     {
-      int adr = rand() & 0xFFFC; // Address is word-aligned
+      int adr = m_random.below(0x10000) & 0xFFFC; // Address is word-aligned
 
-      tlm::tlm_command cmd = static_cast<tlm::tlm_command>(rand() % 2);
-      if (cmd == tlm::TLM_WRITE_COMMAND) data[i % 16] = adr;
+      tlm::tlm_command cmd = static_cast<tlm::tlm_command>(m_random.below(2));
 
       // Grab a new transaction from the memory manager
       trans = m_mm.allocate();
       trans->acquire();
 
+      // The payload carries its own data, so any number of transactions may be in flight
+      int* data = reinterpret_cast<int*>( m_mm.data(trans, 4) );
+      if (cmd == tlm::TLM_WRITE_COMMAND) *data = adr;
+
       trans->set_command( cmd );
       trans->set_address( adr );
-      trans->set_data_ptr( reinterpret_cast<unsigned char*>(&data[i % 16]) );
+      trans->set_data_ptr( reinterpret_cast<unsigned char*>(data) );
       trans->set_data_length( 4 );
       trans->set_streaming_width( 4 );
       trans->set_byte_enable_ptr( 0 );
@@ -76,11 +83,9 @@ struct AT_typeA_initiator: sc_module
       phase = tlm::BEGIN_REQ;
 
       // Timing annotation models processing time of initiator prior to call
-      delay = sc_time(rand_ps(), SC_PS);
+      delay = sc_time(rand_ps(m_random), SC_PS);
 
-      fout << hex << adr << " new, cmd=" << (cmd ? "write" : "read")
-           << ", data=" << hex << data[i % 16] << " at time " << sc_time_stamp()
-           << " in " << name() << endl;
+      trans_log.record( this, Transaction_record::NEW, cmd, adr, *data );
 
       // Non-blocking transport call on the forward path
       tlm::tlm_sync_enum status;
@@ -103,7 +108,7 @@ struct AT_typeA_initiator: sc_module
         // Allow the memory manager to free the transaction object
         trans->release();
       }
-      wait( sc_time(rand_ps(), SC_PS) );
+      wait( sc_time(rand_ps(m_random), SC_PS) );
     }
   }
 
@@ -136,7 +141,7 @@ struct AT_typeA_initiator: sc_module
 
       // Send final phase transition to target
       tlm::tlm_phase fw_phase = tlm::END_RESP;
-      sc_time delay = sc_time(rand_ps(), SC_PS);
+      sc_time delay = sc_time(rand_ps(m_random), SC_PS);
       socket->nb_transport_fw( trans, fw_phase, delay );
       // Ignore return value
 
@@ -160,19 +165,17 @@ struct AT_typeA_initiator: sc_module
     sc_dt::uint64    adr = trans.get_address();
     int*             ptr = reinterpret_cast<int*>( trans.get_data_ptr() );
 
-    fout << hex << adr << " check, cmd=" << (cmd ? "write" : "read")
-         << ", data=" << hex << *ptr << " at time " << sc_time_stamp()
-         << " in " << name() << endl;
+    trans_log.record( this, Transaction_record::CHECK, cmd, adr, *ptr );
 
     if (cmd == tlm::TLM_READ_COMMAND)
       assert( *ptr == -int(adr) );
   }
 
   mm   m_mm;
-  int  data[16];
   tlm::tlm_generic_payload* req_in_progress;
   sc_event end_req_event;
   tlm_utils::peq_with_cb_and_phase<AT_typeA_initiator> m_peq;
+  Random_stream m_random;
 };
 
 #endif
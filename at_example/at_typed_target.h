@@ -18,6 +18,9 @@
 //----------------------------------------------------------------------
 
 // Version 1  09-Sep-2008
+// Version 2  16-Oct-2026  Burst and byte-enable transfers
+// Version 3  16-Oct-2026  Transactions recorded in the transaction log
+// Version 4  16-Oct-2026  Random numbers from a stream of its own
 
 
 #ifndef __AT_TYPED_TARGET_H__
@@ -38,6 +41,7 @@ struct AT_typeD_target: sc_module
   : socket("socket")
   , response_in_progress(false)
   , next_response_pending(0)
+  , m_random(name())
   {
     socket.register_nb_transport_fw(this, &AT_typeD_target::nb_transport_fw);
 
@@ -51,37 +55,25 @@ struct AT_typeD_target: sc_module
   {
     if (phase == tlm::BEGIN_REQ)
     {
-      trans.acquire();
-
       tlm::tlm_command cmd = trans.get_command();
       sc_dt::uint64    adr = trans.get_address();
-      unsigned char*   ptr = trans.get_data_ptr();
-      unsigned int     len = trans.get_data_length();
-      unsigned char*   byt = trans.get_byte_enable_ptr();
-      unsigned int     wid = trans.get_streaming_width();
 
-      if (byt != 0) {
-        trans.set_response_status( tlm::TLM_BYTE_ENABLE_ERROR_RESPONSE );
-        return tlm::TLM_COMPLETED;
-      }
-      if (len > 4 || wid < len) {
-        trans.set_response_status( tlm::TLM_BURST_ERROR_RESPONSE );
+      if ( !check_burst(trans) )
         return tlm::TLM_COMPLETED;
-      }
+
+      trans.acquire();
 
       if ( cmd == tlm::TLM_READ_COMMAND )
       {
-        *reinterpret_cast<int*>(ptr) = -int(adr);
-        fout << hex << adr << " Execute READ, data = " << *reinterpret_cast<int*>(ptr)
-             << " in " << name() << endl;
+        execute_read( trans );
+        trans_log.record( this, Transaction_record::EXECUTE, cmd, adr, first_word(trans) );
       }
       else if ( cmd == tlm::TLM_WRITE_COMMAND )
-        fout << hex << adr << " Execute WRITE, data = " << *reinterpret_cast<int*>(ptr)
-             << " in " << name() << endl;
+        trans_log.record( this, Transaction_record::EXECUTE, cmd, adr, first_word(trans) );
 
       trans.set_response_status( tlm::TLM_OK_RESPONSE );
 
-      delay = delay + sc_time(rand_ps(), SC_PS); // Latency
+      delay = delay + sc_time(rand_ps(m_random), SC_PS) + burst_latency(trans); // Latency
 
       // Target must honor BEGIN_RESP/END_RESP exclusion rule
       // i.e. must not send BEGIN_RESP until receiving previous END_RESP or BEGIN_REQ
@@ -161,6 +153,7 @@ struct AT_typeD_target: sc_module
 
   tlm::tlm_generic_payload*  next_response_pending;
   sc_time                    next_response_time;
+  Random_stream              m_random;
 };
 
 #endif
@@ -18,6 +18,9 @@
 //----------------------------------------------------------------------
 
 // Version 1  09-Sep-2008
+// Version 2  16-Oct-2026  Include burst.h
+// Version 3  16-Oct-2026  Transaction log
+// Version 4  16-Oct-2026  Random delays drawn from a stream per module
 
 
 #ifndef __COMMON_HEADER_H__
@@ -41,6 +44,9 @@ using namespace std;
 
 #include "mm.h"
 #include "tlm2_base_protocol_checker.h"
+#include "burst.h"
+#include "transaction_log.h"
+#include "random_source.h"
 
 #include <iomanip>
 #include <deque>
@@ -48,12 +54,15 @@ using namespace std;
 
 static ofstream fout("example.log");
 
+// Records the events of the initiators and targets, by default as text in fout
+static Transaction_log trans_log(fout);
+
 // Generate a random delay (with power-law distribution) to aid testing and stress the protocol
-int rand_ps()
+// Each module passes its own stream, so that its delays do not depend on the other modules
+int rand_ps( Random_stream& random )
 {
-  int n = rand() % 100;
-  n = n * n * n;
-  return n / 100;
+  double u = random.uniform();
+  return int(u * u * u * 9703);
 }
 
 DECLARE_EXTENDED_PHASE(internal_ph);
@@ -0,0 +1,234 @@
+
+// Filename: initiator_engine.h
+
+//----------------------------------------------------------------------
+//  Licensed under the Apache License, Version 2.0 (the "License");
+//  you may not use this file except in compliance with the License.
+//  You may obtain a copy of the License at
+//
+//  http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+//----------------------------------------------------------------------
+
+// Version 1  16-Oct-2026
+
+
+// *******************************************************************
+// Issue and response engine shared by the benchmark initiators
+// *******************************************************************
+
+/*
+Initiator_engine issues transactions through nb_transport_fw (AT) or b_transport (LT),
+completes them, and keeps the statistics of the run. A derived initiator only decides what
+to issue and when: its thread calls wait_for_slot(), then allocate() and issue() for each
+request.
+
+wait_for_slot() holds a request back while the outstanding limit is reached or an earlier
+request has yet to see END_REQ. LT allows one request at a time, since b_transport blocks.
+*/
+
+#ifndef __INITIATOR_ENGINE_H__
+#define __INITIATOR_ENGINE_H__
+
+#include "common_header.h"
+
+#include <map>
+
+struct Initiator_engine: sc_module
+{
+  enum protocol_t { AT, LT };
+
+  tlm_utils::simple_initiator_socket<Initiator_engine, 32> socket;
+
+  Initiator_engine( sc_module_name name, protocol_t protocol )
+  : socket("socket")
+  , n_issued(0)
+  , n_done(0)
+  , n_reads(0)
+  , n_writes(0)
+  , n_errors(0)
+  , bytes(0)
+  , total_latency(SC_ZERO_TIME)
+  , max_latency(SC_ZERO_TIME)
+  , m_protocol(protocol)
+  , n_outstanding(0)
+  , req_in_progress(0)
+  , m_peq(this, &Initiator_engine::peq_cb)
+  {
+    socket.register_nb_transport_bw(this, &Initiator_engine::nb_transport_bw);
+  }
+
+  // Waits until a request may be issued, with at most limit outstanding (0 = no limit)
+  void wait_for_slot( unsigned int limit )
+  {
+    if (m_protocol == LT)
+      limit = 1;
+
+    while (limit && n_outstanding >= limit)
+      wait(response_event);
+    if (req_in_progress)
+      wait(end_req_event);
+  }
+
+  // A transaction from the pool, with a data buffer of size bytes
+  tlm::tlm_generic_payload* allocate( tlm::tlm_command cmd, sc_dt::uint64 address, unsigned int size )
+  {
+    tlm::tlm_generic_payload* trans = m_mm.allocate();
+    trans->acquire();
+
+    trans->set_command( cmd );
+    trans->set_address( address );
+    trans->set_data_ptr( m_mm.data(trans, size) );
+    trans->set_data_length( size );
+    trans->set_streaming_width( size );
+    trans->set_byte_enable_ptr( 0 );
+    trans->set_dmi_allowed( false );
+    trans->set_response_status( tlm::TLM_INCOMPLETE_RESPONSE );
+    return trans;
+  }
+
+  void issue( tlm::tlm_generic_payload& trans )
+  {
+    if (n_issued++ == 0)
+      first_req = sc_time_stamp();
+    issue_time[&trans] = sc_time_stamp();
+    n_outstanding++;
+
+    if (m_protocol == LT)
+      transport_lt( trans );
+    else
+      transport_at( trans );
+  }
+
+  void transport_lt( tlm::tlm_generic_payload& trans )
+  {
+    sc_time delay = SC_ZERO_TIME;
+    socket->b_transport( trans, delay );
+    wait( delay );
+
+    response( trans );
+    trans.release();
+  }
+
+  void transport_at( tlm::tlm_generic_payload& trans )
+  {
+    req_in_progress = &trans;
+
+    tlm::tlm_phase phase = tlm::BEGIN_REQ;
+    sc_time delay = SC_ZERO_TIME;
+
+    tlm::tlm_sync_enum status = socket->nb_transport_fw( trans, phase, delay );
+
+    if (status == tlm::TLM_UPDATED)
+      m_peq.notify( trans, phase, delay );
+    else if (status == tlm::TLM_COMPLETED)
+    {
+      req_in_progress = 0;
+      response( trans );
+      trans.release();
+    }
+  }
+
+  virtual tlm::tlm_sync_enum nb_transport_bw( tlm::tlm_generic_payload& trans,
+                                              tlm::tlm_phase& phase, sc_time& delay )
+  {
+    m_peq.notify( trans, phase, delay );
+    return tlm::TLM_ACCEPTED;
+  }
+
+  void peq_cb( tlm::tlm_generic_payload& trans, const tlm::tlm_phase& phase )
+  {
+    // BEGIN_RESP implies END_REQ
+    if (&trans == req_in_progress)
+    {
+      req_in_progress = 0;
+      end_req_event.notify();
+    }
+
+    if (phase == tlm::BEGIN_RESP)
+    {
+      response( trans );
+
+      tlm::tlm_phase fw_phase = tlm::END_RESP;
+      sc_time delay = SC_ZERO_TIME;
+      socket->nb_transport_fw( trans, fw_phase, delay );
+      trans.release();
+    }
+  }
+
+  void response( tlm::tlm_generic_payload& trans )
+  {
+    std::map<tlm::tlm_generic_payload*, sc_time>::iterator it = issue_time.find(&trans);
+    sc_time latency = sc_time_stamp() - it->second;
+    issue_time.erase(it);
+
+    total_latency += latency;
+    if (latency > max_latency)
+      max_latency = latency;
+
+    if (trans.is_response_error())
+      n_errors++;
+    else if (trans.is_read())
+      n_reads++;
+    else
+      n_writes++;
+    bytes += trans.get_data_length();
+
+    n_done++;
+    n_outstanding--;
+    last_rsp = sc_time_stamp();
+    response_event.notify();
+  }
+
+  bool finished() const { return n_done == n_issued; }
+
+  sc_time mean_latency() const
+  {
+    return n_done ? total_latency / double(n_done) : SC_ZERO_TIME;
+  }
+
+  // Bytes per microsecond from the first request to the last response
+  double bandwidth() const
+  {
+    double us = (last_rsp - first_req).to_seconds() * 1e6;
+    return us > 0 ? bytes / us : 0.0;
+  }
+
+  void report( std::ostream& os ) const
+  {
+    os << name() << ": " << n_done << " transactions (" << n_reads << " reads, "
+       << n_writes << " writes, " << n_errors << " errors), " << bandwidth() << " bytes/us, "
+       << "latency mean " << mean_latency() << " max " << max_latency << "\n";
+  }
+
+  // Statistics
+  sc_dt::uint64 n_issued;
+  sc_dt::uint64 n_done;
+  sc_dt::uint64 n_reads;
+  sc_dt::uint64 n_writes;
+  sc_dt::uint64 n_errors;
+  sc_dt::uint64 bytes;
+  sc_time       total_latency;
+  sc_time       max_latency;
+  sc_time       first_req;
+  sc_time       last_rsp;
+
+protected:
+  protocol_t    m_protocol;
+
+private:
+  mm            m_mm;
+  unsigned int  n_outstanding;
+  tlm::tlm_generic_payload* req_in_progress;
+  sc_event      end_req_event;
+  sc_event      response_event;
+  std::map<tlm::tlm_generic_payload*, sc_time> issue_time;
+  tlm_utils::peq_with_cb_and_phase<Initiator_engine> m_peq;
+};
+
+#endif
@@ -0,0 +1,282 @@
+
+// Filename: interconnect_stats.h
+
+//----------------------------------------------------------------------
+//  Licensed under the Apache License, Version 2.0 (the "License");
+//  you may not use this file except in compliance with the License.
+//  You may obtain a copy of the License at
+//
+//  http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+//----------------------------------------------------------------------
+
+// Version 1  16-Oct-2026
+
+
+// *******************************************************************
+// Latency and occupancy statistics collected by AT_interconnect
+// *******************************************************************
+
+/*
+One Socket_stats is kept for every target socket and every initiator socket of the interconnect.
+Recording a sample costs a few integer operations, so statistics are always collected.
+
+For a target:
+  queue_delay    From the time a request was due to arrive to the time it was sent to the target
+  service_time   From sending BEGIN_REQ to the target until the target finished the transaction
+  queue          Requests waiting in the arbiter
+  in_flight      Transactions sent to the target and not yet finished by it
+
+For an initiator:
+  queue_delay    Time a response spent in rsp_queue, waiting for the response exclusion rule
+  service_time   From BEGIN_REQ to the response being passed back towards the initiator
+  queue          Responses waiting in rsp_queue
+  in_flight      Responses parked for in-order delivery
+
+Times are in picoseconds and are kept in histograms with power-of-two bucket boundaries.
+Bucket 0 counts zero samples and bucket b counts samples in [2^(b-1), 2^b).
+*/
+
+#ifndef __INTERCONNECT_STATS_H__
+#define __INTERCONNECT_STATS_H__
+
+#include "systemc"
+
+#include <vector>
+#include <string>
+#include <ostream>
+
+struct Log2_histogram
+{
+  static const unsigned int N_BUCKETS = 65;
+
+  Log2_histogram() : count(0), sum(0), min(0), max(0)
+  {
+    for (unsigned int b = 0; b < N_BUCKETS; b++)
+      bucket[b] = 0;
+  }
+
+  void record( sc_dt::uint64 value )
+  {
+    bucket[ bucket_of(value) ]++;
+    if (count == 0 || value < min) min = value;
+    if (value > max)               max = value;
+    count++;
+    sum += value;
+  }
+
+  double mean() const { return count ? double(sum) / count : 0.0; }
+
+  // Upper bound of the bucket holding the q-th quantile (0 < q <= 1)
+  sc_dt::uint64 quantile( double q ) const
+  {
+    sc_dt::uint64 rank = sc_dt::uint64(q * count + 0.5);
+    sc_dt::uint64 seen = 0;
+    for (unsigned int b = 0; b < N_BUCKETS; b++)
+    {
+      seen += bucket[b];
+      if (seen >= rank && seen > 0)
+        return b == 0 ? 0 : (b == 64 ? max : (sc_dt::uint64(1) << b) - 1);
+    }
+    return max;
+  }
+
+  static unsigned int bucket_of( sc_dt::uint64 value )
+  {
+    if (value == 0)
+      return 0;
+#ifdef __GNUC__
+    return 64 - __builtin_clzll( value );
+#else
+    unsigned int b = 0;
+    while (value)
+    {
+      value >>= 1;
+      b++;
+    }
+    return b;
+#endif
+  }
+
+  static sc_dt::uint64 bucket_low( unsigned int b )
+  {
+    return b == 0 ? 0 : sc_dt::uint64(1) << (b - 1);
+  }
+
+  sc_dt::uint64 bucket[N_BUCKETS];
+  sc_dt::uint64 count;
+  sc_dt::uint64 sum;
+  sc_dt::uint64 min;
+  sc_dt::uint64 max;
+};
+
+
+// Peak and time-weighted mean of a level, such as the depth of a queue
+struct Occupancy
+{
+  Occupancy() : level(0), peak(0), area(0.0), last(sc_core::SC_ZERO_TIME) {}
+
+  void set( unsigned int new_level )
+  {
+    sc_core::sc_time now = sc_core::sc_time_stamp();
+    area += level * (now - last).to_seconds();
+    last  = now;
+    level = new_level;
+    if (level > peak)
+      peak = level;
+  }
+
+  double mean( const sc_core::sc_time& end ) const
+  {
+    double total = end.to_seconds();
+    if (total <= 0.0)
+      return level;
+    return (area + level * (end - last).to_seconds()) / total;
+  }
+
+  unsigned int     level;
+  unsigned int     peak;
+  double           area;
+  sc_core::sc_time last;
+};
+
+
+struct Socket_stats
+{
+  Socket_stats() : transactions(0), bytes(0) {}
+
+  sc_dt::uint64  transactions;
+  sc_dt::uint64  bytes;
+  Log2_histogram queue_delay;
+  Log2_histogram service_time;
+  Occupancy      queue;
+  Occupancy      in_flight;
+};
+
+
+class Interconnect_stats
+{
+public:
+  std::vector<Socket_stats> target;
+  std::vector<Socket_stats> init;
+
+  void resize( unsigned int n_targets, unsigned int n_inits )
+  {
+    target.resize(n_targets);
+    init.resize(n_inits);
+  }
+
+  static sc_dt::uint64 ps( const sc_core::sc_time& t )
+  {
+    return sc_dt::uint64( t.to_seconds() * 1e12 + 0.5 );
+  }
+
+  // Time from 'from' until now, or zero if 'from' is still in the future
+  static sc_dt::uint64 ps_since( const sc_core::sc_time& from )
+  {
+    sc_core::sc_time now = sc_core::sc_time_stamp();
+    return from < now ? ps(now - from) : 0;
+  }
+
+  void write_json( std::ostream& os, const char* name ) const
+  {
+    sc_core::sc_time end = sc_core::sc_time_stamp();
+
+    os << "{\n  \"name\": \"" << name << "\",\n"
+       << "  \"sim_time_ps\": " << ps(end) << ",\n";
+    write_json_sockets( os, "targets", target, end );
+    os << ",\n";
+    write_json_sockets( os, "initiators", init, end );
+    os << "\n}\n";
+  }
+
+  void write_csv( std::ostream& os, const char* name ) const
+  {
+    sc_core::sc_time end = sc_core::sc_time_stamp();
+
+    os << "interconnect,socket,index,transactions,bytes,transactions_per_s,"
+          "queue_peak,queue_mean,in_flight_peak,in_flight_mean,"
+          "queue_delay_mean_ps,queue_delay_p99_ps,queue_delay_max_ps,"
+          "service_time_mean_ps,service_time_p99_ps,service_time_max_ps\n";
+
+    for (unsigned int i = 0; i < target.size(); i++)
+      write_csv_row( os, name, "target", i, target[i], end );
+    for (unsigned int i = 0; i < init.size(); i++)
+      write_csv_row( os, name, "initiator", i, init[i], end );
+  }
+
+private:
+  static double per_second( sc_dt::uint64 n, const sc_core::sc_time& end )
+  {
+    return end.to_seconds() > 0.0 ? n / end.to_seconds() : 0.0;
+  }
+
+  static void write_json_histogram( std::ostream& os, const char* key, const Log2_histogram& h )
+  {
+    os << "\"" << key << "\": {\"count\": " << h.count
+       << ", \"mean\": " << h.mean()
+       << ", \"min\": " << h.min
+       << ", \"max\": " << h.max
+       << ", \"p50\": " << h.quantile(0.5)
+       << ", \"p99\": " << h.quantile(0.99)
+       << ", \"buckets\": [";
+
+    bool first = true;
+    for (unsigned int b = 0; b < Log2_histogram::N_BUCKETS; b++)
+    {
+      if (h.bucket[b] == 0)
+        continue;
+      os << (first ? "" : ", ") << "[" << Log2_histogram::bucket_low(b) << ", " << h.bucket[b] << "]";
+      first = false;
+    }
+    os << "]}";
+  }
+
+  static void write_json_occupancy( std::ostream& os, const char* key, const Occupancy& o,
+                                    const sc_core::sc_time& end )
+  {
+    os << "\"" << key << "\": {\"peak\": " << o.peak << ", \"mean\": " << o.mean(end) << "}";
+  }
+
+  static void write_json_sockets( std::ostream& os, const char* key,
+                                  const std::vector<Socket_stats>& v, const sc_core::sc_time& end )
+  {
+    os << "  \"" << key << "\": [";
+    for (unsigned int i = 0; i < v.size(); i++)
+    {
+      const Socket_stats& s = v[i];
+      os << (i ? ",\n" : "\n") << "    {\"index\": " << i
+         << ", \"transactions\": " << s.transactions
+         << ", \"bytes\": " << s.bytes
+         << ", \"transactions_per_s\": " << per_second(s.transactions, end) << ",\n     ";
+      write_json_occupancy( os, "queue", s.queue, end );
+      os << ", ";
+      write_json_occupancy( os, "in_flight", s.in_flight, end );
+      os << ",\n     ";
+      write_json_histogram( os, "queue_delay_ps", s.queue_delay );
+      os << ",\n     ";
+      write_json_histogram( os, "service_time_ps", s.service_time );
+      os << "}";
+    }
+    os << "\n  ]";
+  }
+
+  static void write_csv_row( std::ostream& os, const char* name, const char* socket,
+                             unsigned int i, const Socket_stats& s, const sc_core::sc_time& end )
+  {
+    os << name << "," << socket << "," << i << ","
+       << s.transactions << "," << s.bytes << "," << per_second(s.transactions, end) << ","
+       << s.queue.peak << "," << s.queue.mean(end) << ","
+       << s.in_flight.peak << "," << s.in_flight.mean(end) << ","
+       << s.queue_delay.mean() << "," << s.queue_delay.quantile(0.99) << "," << s.queue_delay.max << ","
+       << s.service_time.mean() << "," << s.service_time.quantile(0.99) << "," << s.service_time.max
+       << "\n";
+  }
+};
+
+#endif
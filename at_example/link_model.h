@@ -0,0 +1,99 @@
+
+// Filename: link_model.h
+
+//----------------------------------------------------------------------
+//  Licensed under the Apache License, Version 2.0 (the "License");
+//  you may not use this file except in compliance with the License.
+//  You may obtain a copy of the License at
+//
+//  http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+//----------------------------------------------------------------------
+
+// Version 1  16-Oct-2026
+
+
+// *******************************************************************
+// Clocked link bandwidth model used by AT_interconnect
+// *******************************************************************
+
+/*
+A Link carries one transfer at a time in one direction. A transfer of n bytes occupies
+max(1, ceil(n / bus_width)) beats of one clock period each, starting on the first clock
+edge at or after both the time the transfer is offered and the end of the previous transfer.
+The link stays busy until its last beat completes.
+
+The first beat of a transfer carries the command and address, so a read request or a write
+response still costs one beat.
+*/
+
+#ifndef __LINK_MODEL_H__
+#define __LINK_MODEL_H__
+
+#include "systemc"
+
+struct Link
+{
+  Link()
+  : bus_width(0)
+  , clock_period(sc_core::SC_ZERO_TIME)
+  , busy_until(sc_core::SC_ZERO_TIME)
+  , busy_total(sc_core::SC_ZERO_TIME)
+  , transfers(0)
+  {}
+
+  void configure( unsigned int width, const sc_core::sc_time& period )
+  {
+    bus_width    = width;
+    clock_period = period;
+  }
+
+  bool enabled() const { return bus_width != 0; }
+
+  unsigned int beats( unsigned int bytes ) const
+  {
+    return bytes <= bus_width ? 1 : (bytes + bus_width - 1) / bus_width;
+  }
+
+  // Occupy the link for a transfer of the given number of bytes, offered at
+  // sc_time_stamp() + delay. On return, delay is the time at which the last beat completes
+  void transfer( unsigned int bytes, sc_core::sc_time& delay )
+  {
+    sc_core::sc_time now   = sc_core::sc_time_stamp();
+    sc_core::sc_time start = now + delay;
+    if (start < busy_until)
+      start = busy_until;
+
+    // Align to the next clock edge
+    sc_dt::uint64 period = clock_period.value();
+    if (start.value() % period)
+      start = sc_core::sc_time::from_value( (start.value() / period + 1) * period );
+
+    sc_core::sc_time duration = beats(bytes) * clock_period;
+    busy_until = start + duration;
+    busy_total += duration;
+    transfers++;
+
+    delay = busy_until - now;
+  }
+
+  // Fraction of the elapsed simulation time during which the link was busy
+  double utilization() const
+  {
+    double t = sc_core::sc_time_stamp().to_seconds();
+    return t > 0.0 ? busy_total.to_seconds() / t : 0.0;
+  }
+
+  unsigned int     bus_width;     // Bytes per beat
+  sc_core::sc_time clock_period;
+  sc_core::sc_time busy_until;    // End of the last beat of the latest transfer
+  sc_core::sc_time busy_total;
+  sc_dt::uint64    transfers;
+};
+
+#endif
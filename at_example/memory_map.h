@@ -0,0 +1,203 @@
+
+// Filename: memory_map.h
+
+//----------------------------------------------------------------------
+//  Licensed under the Apache License, Version 2.0 (the "License");
+//  you may not use this file except in compliance with the License.
+//  You may obtain a copy of the License at
+//
+//  http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+//----------------------------------------------------------------------
+
+// Version 1  16-Oct-2026
+
+
+// *******************************************************************
+// Range-table memory map used by AT_interconnect to decode addresses
+// *******************************************************************
+
+/*
+Each region maps the system addresses [base, base + size) onto one target socket of the
+interconnect. The address presented to the target is (address - base + offset).
+
+Regions may be added at any time during elaboration, either one by one with add_region()
+or from a text file with load(). The map is frozen by build(), which sorts the regions into
+flat arrays so that decode() is a binary search over a contiguous array of base addresses.
+
+Text file format, one region per line, numbers in decimal or 0x-prefixed hex:
+
+  # base        size      target  [offset]
+  0x00000000    0x1000    0
+  0x80000000    0x100000  1       0x0
+*/
+
+#ifndef __MEMORY_MAP_H__
+#define __MEMORY_MAP_H__
+
+#include "systemc"
+
+#include <vector>
+#include <algorithm>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <cstdlib>
+
+struct Memory_region
+{
+  sc_dt::uint64 base;    // First address of region in system memory map
+  sc_dt::uint64 size;    // Number of bytes in region
+  unsigned int  target;  // Index of interconnect initiator socket
+  sc_dt::uint64 offset;  // Address seen by target at the base of the region
+
+  sc_dt::uint64 last()       const { return base + (size - 1); }
+  sc_dt::uint64 local_last() const { return offset + (size - 1); }
+
+  sc_dt::uint64 to_local ( sc_dt::uint64 address ) const { return address - base + offset; }
+  sc_dt::uint64 to_global( sc_dt::uint64 address ) const { return address - offset + base; }
+};
+
+
+class Memory_map
+{
+public:
+  Memory_map() : m_built(false) {}
+
+  void add_region( sc_dt::uint64 base, sc_dt::uint64 size, unsigned int target,
+                   sc_dt::uint64 offset = 0 )
+  {
+    if (m_built)
+      SC_REPORT_FATAL("Memory_map", "Region added after the memory map was built");
+
+    Memory_region r;
+    r.base   = base;
+    r.size   = size;
+    r.target = target;
+    r.offset = offset;
+    m_regions.push_back(r);
+  }
+
+  // Read regions from a text file. Returns false if the file cannot be opened
+  bool load( const char* filename )
+  {
+    std::ifstream in(filename);
+    if (!in)
+      return false;
+
+    std::string line;
+    unsigned int line_nr = 0;
+    while (std::getline(in, line))
+    {
+      line_nr++;
+      std::string::size_type hash = line.find('#');
+      if (hash != std::string::npos)
+        line.erase(hash);
+
+      std::istringstream fields(line);
+      std::string tok[4];
+      int n = 0;
+      while (n < 4 && fields >> tok[n])
+        n++;
+
+      if (n == 0)
+        continue;
+      if (n < 3)
+      {
+        std::ostringstream txt;
+        txt << filename << ":" << line_nr << ": expected <base> <size> <target> [<offset>]";
+        SC_REPORT_FATAL("Memory_map", txt.str().c_str());
+      }
+
+      add_region( strtoull(tok[0].c_str(), 0, 0),
+                  strtoull(tok[1].c_str(), 0, 0),
+                  (unsigned int)strtoul(tok[2].c_str(), 0, 0),
+                  n == 4 ? strtoull(tok[3].c_str(), 0, 0) : 0 );
+    }
+    return true;
+  }
+
+  // Sort and validate the regions. Called from end_of_elaboration
+  void build( unsigned int n_targets )
+  {
+    std::sort(m_regions.begin(), m_regions.end(), base_less);
+
+    m_base.resize(m_regions.size());
+    m_by_target.assign(n_targets, std::vector<unsigned int>());
+
+    for (unsigned int i = 0; i < m_regions.size(); i++)
+    {
+      const Memory_region& r = m_regions[i];
+      std::ostringstream txt;
+
+      if (r.size == 0)
+        txt << "Region at 0x" << std::hex << r.base << " has zero size";
+      else if (r.size - 1 > ~sc_dt::uint64(0) - r.base)
+        txt << "Region at 0x" << std::hex << r.base << " wraps past the top of the address space";
+      else if (r.target >= n_targets)
+        txt << "Region at 0x" << std::hex << r.base << " maps to target " << std::dec
+            << r.target << " but only " << n_targets << " targets are bound";
+      else if (i > 0 && r.base <= m_regions[i-1].last())
+        txt << "Region at 0x" << std::hex << r.base << " overlaps region at 0x"
+            << m_regions[i-1].base;
+
+      if (!txt.str().empty())
+        SC_REPORT_FATAL("Memory_map", txt.str().c_str());
+
+      m_base[i] = r.base;
+      m_by_target[r.target].push_back(i);
+    }
+    m_built = true;
+  }
+
+  bool   empty() const { return m_regions.empty(); }
+  size_t size()  const { return m_regions.size(); }
+
+  const Memory_region& region( unsigned int i ) const { return m_regions[i]; }
+
+  // Indices of all regions that map onto the given target
+  const std::vector<unsigned int>& regions_of( unsigned int target ) const
+  {
+    return m_by_target[target];
+  }
+
+  // Find the region containing address, or 0 if the address is unmapped
+  const Memory_region* decode( sc_dt::uint64 address ) const
+  {
+    size_t n = m_base.size();
+    if (n == 0 || address < m_base[0])
+      return 0;
+
+    // Branch-free binary search for the last base <= address
+    const sc_dt::uint64* first = &m_base[0];
+    while (n > 1)
+    {
+      size_t half = n / 2;
+      first = (first[half] <= address) ? first + half : first;
+      n -= half;
+    }
+
+    const Memory_region* r = &m_regions[first - &m_base[0]];
+    if (address > r->last())
+      return 0;
+    return r;
+  }
+
+private:
+  static bool base_less( const Memory_region& a, const Memory_region& b )
+  {
+    return a.base < b.base;
+  }
+
+  bool                                    m_built;
+  std::vector<Memory_region>              m_regions;    // Sorted by base after build()
+  std::vector<sc_dt::uint64>              m_base;       // Copy of bases, searched by decode()
+  std::vector< std::vector<unsigned int> > m_by_target;
+};
+
+#endif
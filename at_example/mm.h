@@ -18,6 +18,9 @@
 //----------------------------------------------------------------------
 
 // Version 1  09-Sep-2008
+// Version 2  16-Oct-2026  Payloads come from a Slab_pool, and are deleted with the mm
+// Version 3  16-Oct-2026  Optional accounting hooks, see mm_accounting.h
+// Version 4  16-Oct-2026  Data storage owned by each payload
 
 
 // *******************************************************************
@@ -25,57 +28,39 @@
 // *******************************************************************
 
 #include "tlm.h"
+#include "slab_pool.h"
+#include "mm_accounting.h"
 
 class mm: public tlm::tlm_mm_interface
 {
   typedef tlm::tlm_generic_payload gp_t;
 
 public:
-  mm() : free_list(0), empties(0) {}
+  // A warning is issued if more than capacity payloads are live at once (0 = no bound)
+  mm( unsigned int capacity = 0 ) : pool(this, capacity) {}
+
+  ~mm() { MM_ACCOUNT( on_destroy(this) ); }
 
   gp_t* allocate();
   void  free(gp_t* trans);
 
-private:
-  struct access
-  {
-    gp_t* trans;
-    access* next;
-    access* prev;
-  };
+  // Data storage owned by a payload from this mm and recycled with it, see slab_pool.h
+  unsigned char* data(gp_t* trans, unsigned int length) { return pool.data(trans, length); }
 
-  access* free_list;
-  access* empties;
+private:
+  Slab_pool pool;
 };
 
 mm::gp_t* mm::allocate()
 {
-  gp_t* ptr;
-  if (free_list)
-  {
-    ptr = free_list->trans;
-    empties = free_list;
-    free_list = free_list->next;
-  }
-  else
-  {
-    ptr = new gp_t(this);
-  }
+  gp_t* ptr = pool.get();
+  MM_ACCOUNT( on_allocate(this, ptr) );
   return ptr;
 }
 
 void mm::free(gp_t* trans)
 {
+  MM_ACCOUNT( on_free(this, trans) );
   trans->reset(); // Delete auto extensions
-  if (!empties)
-  {
-    empties = new access;
-    empties->next = free_list;
-    empties->prev = 0;
-    if (free_list)
-      free_list->prev = empties;
-  }
-  free_list = empties;
-  free_list->trans = trans;
-  empties = free_list->prev;
+  pool.put(trans);
 }
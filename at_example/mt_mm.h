@@ -0,0 +1,267 @@
+
+// Filename: mt_mm.h
+
+//----------------------------------------------------------------------
+//  Licensed under the Apache License, Version 2.0 (the "License");
+//  you may not use this file except in compliance with the License.
+//  You may obtain a copy of the License at
+//
+//  http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+//----------------------------------------------------------------------
+
+// Version 1  16-Oct-2026
+
+
+// *******************************************************************
+// Memory manager that may be used from any host thread
+// *******************************************************************
+
+/*
+mt_mm can be used in place of mm when payloads are allocated or freed outside the SystemC
+kernel thread, for example by accelerator models that post completions from their own
+threads through async_request_update.
+
+Each thread keeps a cache of up to CACHE_SIZE free payloads per pool, so most calls touch
+no shared state. When its cache is empty or full, a thread moves half a cache to or from a
+global free list, which is a lock-free stack. The stack holds slot indices rather than
+pointers, with a tag that is incremented on every update to rule out ABA. Only growing
+the pool, which constructs a new chunk of payloads, takes a mutex.
+
+A payload is owned by one thread at a time: the reference count of the generic payload is
+not atomic, so a payload must be handed between threads through something that
+synchronizes, such as a queue with a mutex or async_request_update.
+
+Every thread that has used a pool must have exited, or called flush_thread_cache, before
+the pool is destroyed.
+*/
+
+#ifndef __MT_MM_H__
+#define __MT_MM_H__
+
+#include "tlm.h"
+
+#include <atomic>
+#include <mutex>
+#include <vector>
+#include <new>
+
+class mt_mm: public tlm::tlm_mm_interface
+{
+  typedef tlm::tlm_generic_payload gp_t;
+
+public:
+  static const unsigned int CACHE_SIZE = 64;
+  static const unsigned int MAX_CHUNKS = 4096;
+
+  mt_mm( unsigned int chunk_size = 256 )
+  : m_chunk_size(chunk_size ? chunk_size : 1)
+  , m_id(next_pool_id()++)
+  , m_head(0)
+  , m_n_chunks(0)
+  {
+    for (unsigned int c = 0; c < MAX_CHUNKS; c++)
+      m_chunks[c].store(0, std::memory_order_relaxed);
+  }
+
+  virtual ~mt_mm()
+  {
+    flush_thread_cache();
+
+    unsigned int n = m_n_chunks.load();
+    for (unsigned int c = 0; c < n; c++)
+    {
+      slot* chunk = m_chunks[c].load();
+      for (unsigned int i = 0; i < m_chunk_size; i++)
+        chunk[i].~slot();
+      ::operator delete( chunk );
+    }
+  }
+
+  gp_t* allocate()
+  {
+    Cache& c = thread_cache();
+    if (c.n == 0)
+      refill(c);
+    return c.s[--c.n];
+  }
+
+  void free( gp_t* trans )
+  {
+    trans->reset(); // Delete auto extensions
+
+    Cache& c = thread_cache();
+    if (c.n == CACHE_SIZE)
+      spill(c, CACHE_SIZE / 2);
+    c.s[c.n++] = static_cast<slot*>(trans);
+  }
+
+  // Return the free payloads cached by the calling thread to the global free list
+  void flush_thread_cache()
+  {
+    Caches& all = caches();
+    if (m_id < all.v.size() && all.v[m_id].pool == this)
+    {
+      spill( all.v[m_id], all.v[m_id].n );
+      all.v[m_id].pool = 0;
+    }
+  }
+
+  // Number of payloads constructed so far
+  unsigned int size() const { return m_n_chunks.load() * m_chunk_size; }
+
+private:
+  struct slot: gp_t
+  {
+    slot( mt_mm* mm, unsigned int i ) : gp_t(mm), index(i), next(0) {}
+
+    unsigned int              index;
+    std::atomic<unsigned int> next;   // Index + 1 of the next free slot, 0 at the end
+  };
+
+  struct Cache
+  {
+    Cache() : pool(0), n(0) {}
+
+    mt_mm*       pool;
+    unsigned int n;
+    slot*        s[CACHE_SIZE];
+  };
+
+  // The caches of one thread, indexed by pool id. Flushed when the thread exits
+  struct Caches
+  {
+    ~Caches()
+    {
+      for (unsigned int i = 0; i < v.size(); i++)
+        if (v[i].pool)
+          v[i].pool->spill( v[i], v[i].n );
+    }
+
+    std::vector<Cache> v;
+  };
+
+  static Caches& caches()
+  {
+    static thread_local Caches c;
+    return c;
+  }
+
+  static std::atomic<unsigned int>& next_pool_id()
+  {
+    static std::atomic<unsigned int> id(0);
+    return id;
+  }
+
+  Cache& thread_cache()
+  {
+    Caches& all = caches();
+    if (m_id >= all.v.size())
+      all.v.resize(m_id + 1);
+    Cache& c = all.v[m_id];
+    c.pool = this;
+    return c;
+  }
+
+  slot* slot_at( unsigned int index ) const
+  {
+    return m_chunks[index / m_chunk_size].load(std::memory_order_acquire) + index % m_chunk_size;
+  }
+
+  // Global free list. The head holds a tag in the upper 32 bits and the index + 1 of the top
+  // slot in the lower 32 bits
+
+  void push( slot* s )
+  {
+    sc_dt::uint64 head = m_head.load(std::memory_order_relaxed);
+    sc_dt::uint64 next;
+    do
+    {
+      s->next.store( (unsigned int)head, std::memory_order_relaxed );
+      next = (((head >> 32) + 1) << 32) | (s->index + 1);
+    }
+    while ( !m_head.compare_exchange_weak(head, next, std::memory_order_release,
+                                                      std::memory_order_relaxed) );
+  }
+
+  slot* pop()
+  {
+    sc_dt::uint64 head = m_head.load(std::memory_order_acquire);
+    for (;;)
+    {
+      unsigned int top = (unsigned int)head;
+      if (!top)
+        return 0;
+
+      slot* s = slot_at(top - 1);
+      sc_dt::uint64 next = (((head >> 32) + 1) << 32) | s->next.load(std::memory_order_relaxed);
+      if ( m_head.compare_exchange_weak(head, next, std::memory_order_acquire,
+                                                    std::memory_order_acquire) )
+        return s;
+    }
+  }
+
+  void spill( Cache& c, unsigned int n )
+  {
+    for ( ; n > 0; n--)
+      push( c.s[--c.n] );
+  }
+
+  void refill( Cache& c )
+  {
+    while (c.n < CACHE_SIZE / 2)
+    {
+      slot* s = pop();
+      if (!s)
+        break;
+      c.s[c.n++] = s;
+    }
+    if (c.n == 0)
+      grow();
+    while (c.n == 0)
+    {
+      slot* s = pop();
+      if (s)
+        c.s[c.n++] = s;
+      else
+        grow();
+    }
+  }
+
+  void grow()
+  {
+    std::lock_guard<std::mutex> lock(m_grow_mutex);
+
+    // Another thread may have grown the pool while this one waited
+    if ((unsigned int)m_head.load(std::memory_order_acquire))
+      return;
+
+    unsigned int c = m_n_chunks.load(std::memory_order_relaxed);
+    if (c == MAX_CHUNKS)
+      SC_REPORT_FATAL("mt_mm", "Transaction pool exhausted");
+
+    slot* chunk = static_cast<slot*>( ::operator new( m_chunk_size * sizeof(slot) ) );
+    for (unsigned int i = 0; i < m_chunk_size; i++)
+      new (&chunk[i]) slot( this, c * m_chunk_size + i );
+
+    m_chunks[c].store(chunk, std::memory_order_release);
+    m_n_chunks.store(c + 1, std::memory_order_release);
+
+    for (unsigned int i = 0; i < m_chunk_size; i++)
+      push( &chunk[i] );
+  }
+
+  unsigned int                 m_chunk_size;
+  unsigned int                 m_id;
+  std::atomic<sc_dt::uint64>   m_head;
+  std::atomic<slot*>           m_chunks[MAX_CHUNKS];
+  std::atomic<unsigned int>    m_n_chunks;
+  std::mutex                   m_grow_mutex;
+};
+
+#endif
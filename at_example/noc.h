@@ -0,0 +1,311 @@
+
+// Filename: noc.h
+
+//----------------------------------------------------------------------
+//  Licensed under the Apache License, Version 2.0 (the "License");
+//  you may not use this file except in compliance with the License.
+//  You may obtain a copy of the License at
+//
+//  http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+//----------------------------------------------------------------------
+
+// Version 1  16-Oct-2026
+
+
+// *******************************************************************
+// Network on chip built from cascaded AT_interconnect routers
+// *******************************************************************
+
+/*
+Noc_fabric instantiates one Noc_router per node, arranged as a cols x rows mesh or as a
+ring of cols x rows nodes, and binds the routers of neighbouring nodes to each other in
+both directions. Every node owns node_size bytes of the system address space, starting at
+node * node_size.
+
+After the fabric has been constructed, each node must have exactly one local target and
+may have one local initiator bound to its router:
+
+  initiator.socket.bind( fabric.router(node)->targ_socket );
+  fabric.router(node)->init_socket.bind( target.socket );
+
+Routing is table driven. The memory map of each router sends the address range of every
+other node to the port towards the next hop, keeping the address unchanged, and sends its
+own range to the local target, translated to start at 0. Meshes use XY routing, rings
+take the shorter direction around the ring.
+
+Each router adds the hop latency to every request and response passing through it, and
+contention for each link between two routers is modelled by the clocked links of the
+interconnect (see set_link). The routers are buffered (see AT_interconnect::set_buffered),
+so a transaction waiting for a busy link never holds the links behind it.
+
+The router where a transaction enters the network attaches a noc_route_extension giving
+its source and destination nodes, and every router on the way counts a hop.
+*/
+
+#ifndef __NOC_H__
+#define __NOC_H__
+
+#include "at_interconnect.h"
+
+#include <vector>
+#include <map>
+
+struct noc_route_extension: tlm_utils::instance_specific_extension<noc_route_extension>
+{
+  unsigned int src;
+  unsigned int dst;
+  unsigned int hops;   // Routers passed through so far
+};
+
+
+struct Noc_router: AT_interconnect
+{
+  Noc_router( sc_module_name name, unsigned int node_id, sc_dt::uint64 size,
+              tlm_utils::instance_specific_extension_accessor& route_accessor )
+  : AT_interconnect(name)
+  , node(node_id)
+  , local_port(0)
+  , node_size(size)
+  , hop_latency(SC_ZERO_TIME)
+  , delivered(0)
+  , hops_total(0)
+  , m_route_accessor(route_accessor)
+  {
+    set_buffered(true);
+  }
+
+  virtual tlm::tlm_sync_enum nb_transport_fw( int id, tlm::tlm_generic_payload& trans,
+                                              tlm::tlm_phase& phase, sc_time& delay )
+  {
+    if (phase == tlm::BEGIN_REQ)
+    {
+      noc_route_extension* ext;
+      m_route_accessor(trans).get_extension(ext);
+
+      if (id == int(local_port))
+      {
+        // Entering the network
+        if (!ext)
+        {
+          ext = new noc_route_extension;
+          m_route_accessor(trans).set_extension(ext);
+        }
+        ext->src  = node;
+        ext->dst  = (unsigned int)(trans.get_address() / node_size);
+        ext->hops = 0;
+      }
+      assert(ext);
+      ext->hops++;
+
+      if (ext->dst == node)
+      {
+        delivered++;
+        hops_total += ext->hops - 1;
+      }
+      delay += hop_latency;
+    }
+    return AT_interconnect::nb_transport_fw( id, trans, phase, delay );
+  }
+
+  virtual tlm::tlm_sync_enum nb_transport_bw( int id, tlm::tlm_generic_payload& trans,
+                                              tlm::tlm_phase& phase, sc_time& delay )
+  {
+    if (phase == tlm::BEGIN_RESP)
+      delay += hop_latency;
+    return AT_interconnect::nb_transport_bw( id, trans, phase, delay );
+  }
+
+  unsigned int  node;
+  unsigned int  local_port;  // Index of the local initiator and target sockets
+  sc_dt::uint64 node_size;
+  sc_time       hop_latency;
+
+  // Requests delivered to the local target, and the links they crossed to get here
+  sc_dt::uint64 delivered;
+  sc_dt::uint64 hops_total;
+
+private:
+  tlm_utils::instance_specific_extension_accessor& m_route_accessor;
+};
+
+
+struct Noc_fabric: sc_module
+{
+  enum topology_t { MESH, RING };
+
+  Noc_fabric( sc_module_name name, topology_t topology, unsigned int cols, unsigned int rows,
+              sc_dt::uint64 size )
+  : m_topology(topology)
+  , m_cols(cols)
+  , m_rows(rows)
+  , m_node_size(size)
+  {
+    unsigned int n = cols * rows;
+    if (n == 0 || size == 0)
+      SC_REPORT_FATAL("Noc_fabric", "A network needs at least one node and a node size");
+
+    for (unsigned int i = 0; i < n; i++)
+    {
+      ostringstream oss;
+      oss << "router_" << i;
+      m_routers.push_back( new Noc_router( oss.str().c_str(), i, size, m_route_accessor ) );
+    }
+
+    // Bind the routers of neighbouring nodes in both directions
+    m_port_to.resize(n);
+    for (unsigned int i = 0; i < n; i++)
+    {
+      if (topology == MESH)
+      {
+        if ((i % cols) + 1 < cols) connect( i, i + 1 );
+        if ((i / cols) + 1 < rows) connect( i, i + cols );
+      }
+      else if (n > 2 || (n == 2 && i == 0))
+        connect( i, (i + 1) % n );
+    }
+
+    // The local sockets are bound next, after the links to the neighbours
+    for (unsigned int i = 0; i < n; i++)
+      m_routers[i]->local_port = m_port_to[i].size();
+
+    for (unsigned int i = 0; i < n; i++)
+      build_routing_table( i );
+  }
+
+  Noc_router*   router( unsigned int node ) { return m_routers[node]; }
+  unsigned int  n_nodes() const             { return m_routers.size(); }
+  sc_dt::uint64 node_base( unsigned int node ) const { return node * m_node_size; }
+
+  // Latency added by every router to each request and each response passing through it
+  void set_hop_latency( const sc_time& t )
+  {
+    for (unsigned int i = 0; i < m_routers.size(); i++)
+      m_routers[i]->hop_latency = t;
+  }
+
+  // Width and clock of every link, including the links to the local initiator and target
+  void set_link( unsigned int bus_width, const sc_time& clock_period )
+  {
+    for (unsigned int i = 0; i < m_routers.size(); i++)
+      m_routers[i]->set_link( bus_width, clock_period );
+  }
+
+  // Number of links crossed from one node to another
+  unsigned int distance( unsigned int from, unsigned int to ) const
+  {
+    unsigned int d = 0;
+    for ( ; from != to; d++)
+      from = next_hop( from, to );
+    return d;
+  }
+
+  sc_dt::uint64 delivered() const
+  {
+    sc_dt::uint64 n = 0;
+    for (unsigned int i = 0; i < m_routers.size(); i++)
+      n += m_routers[i]->delivered;
+    return n;
+  }
+
+  double mean_hops() const
+  {
+    sc_dt::uint64 n = 0, hops = 0;
+    for (unsigned int i = 0; i < m_routers.size(); i++)
+    {
+      n    += m_routers[i]->delivered;
+      hops += m_routers[i]->hops_total;
+    }
+    return n ? double(hops) / n : 0.0;
+  }
+
+  // Peak fraction of time for which any request link between two routers was busy
+  double peak_link_utilization() const
+  {
+    double peak = 0.0;
+    for (unsigned int i = 0; i < m_routers.size(); i++)
+      for (std::map<unsigned int, unsigned int>::const_iterator it = m_port_to[i].begin();
+           it != m_port_to[i].end(); ++it)
+      {
+        double u = m_routers[i]->get_request_link( it->second ).utilization();
+        if (u > peak)
+          peak = u;
+      }
+    return peak;
+  }
+
+private:
+
+  void connect( unsigned int a, unsigned int b )
+  {
+    unsigned int port_a = m_port_to[a].size();
+    unsigned int port_b = m_port_to[b].size();
+
+    m_port_to[a][b] = port_a;
+    m_routers[a]->init_socket.bind( m_routers[b]->targ_socket );
+
+    m_port_to[b][a] = port_b;
+    m_routers[b]->init_socket.bind( m_routers[a]->targ_socket );
+  }
+
+  unsigned int next_hop( unsigned int from, unsigned int to ) const
+  {
+    if (m_topology == MESH)
+    {
+      // X first, then Y
+      unsigned int x = from % m_cols, tx = to % m_cols;
+      if (tx != x)
+        return tx > x ? from + 1 : from - 1;
+      return to > from ? from + m_cols : from - m_cols;
+    }
+
+    unsigned int n   = m_routers.size();
+    unsigned int fwd = (to + n - from) % n;
+    return fwd <= n / 2 ? (from + 1) % n : (from + n - 1) % n;
+  }
+
+  // Routing table of one router, as memory map regions. Consecutive nodes reached through
+  // the same port share one region, since the address is passed on unchanged
+  void build_routing_table( unsigned int node )
+  {
+    Noc_router*  r = m_routers[node];
+    unsigned int n = m_routers.size();
+
+    for (unsigned int d = 0; d < n; )
+    {
+      if (d == node)
+      {
+        r->map_region( node_base(d), m_node_size, r->local_port, 0 );
+        d++;
+        continue;
+      }
+
+      unsigned int port = m_port_to[node][ next_hop(node, d) ];
+      unsigned int e = d + 1;
+      while (e < n && e != node && m_port_to[node][ next_hop(node, e) ] == port)
+        e++;
+
+      r->map_region( node_base(d), (e - d) * m_node_size, port, node_base(d) );
+      d = e;
+    }
+  }
+
+  topology_t    m_topology;
+  unsigned int  m_cols;
+  unsigned int  m_rows;
+  sc_dt::uint64 m_node_size;
+
+  std::vector<Noc_router*> m_routers;
+
+  // Per node, the init_socket index of the link to each neighbour
+  std::vector< std::map<unsigned int, unsigned int> > m_port_to;
+
+  tlm_utils::instance_specific_extension_accessor m_route_accessor;
+};
+
+#endif
@@ -0,0 +1,211 @@
+
+// Filename: random_source.h
+
+//----------------------------------------------------------------------
+//  Licensed under the Apache License, Version 2.0 (the "License");
+//  you may not use this file except in compliance with the License.
+//  You may obtain a copy of the License at
+//
+//  http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+//----------------------------------------------------------------------
+
+// Version 1  16-Oct-2026
+// Version 2  16-Oct-2026  below() rejects the draws that would bias it
+
+
+// *******************************************************************
+// Reproducible random number streams, one per module instance
+// *******************************************************************
+
+/*
+Random_stream is a xoshiro256** generator. A module constructs its own stream from its
+hierarchical name, and the stream is seeded from a hash of the name combined with the
+global seed:
+
+  SC_CTOR(Module) : m_random(name()) { ... }
+
+so each module draws the same numbers whatever other modules are added, removed or
+reordered, and no module disturbs the numbers drawn by another. Changing the global seed
+with Random_stream::set_global_seed(), before the modules are constructed, gives a
+different but equally reproducible run.
+
+fill() writes random bytes into a buffer of any length, eight at a time.
+
+The delay distributions draw from a stream passed in: Fixed_delay, Uniform_delay between
+two bounds, Power_law_delay, in which most delays are short but some are close to the
+maximum, and Empirical_delay, which picks from a table of delays with relative weights.
+*/
+
+#ifndef __RANDOM_SOURCE_H__
+#define __RANDOM_SOURCE_H__
+
+#include "systemc"
+
+#include <vector>
+#include <algorithm>
+#include <cstring>
+#include <cmath>
+
+class Random_stream
+{
+public:
+  Random_stream( const char* name )
+  {
+    // FNV-1a hash of the name
+    sc_dt::uint64 h = 0xCBF29CE484222325ULL;
+    for (const char* p = name; *p; p++)
+      h = (h ^ (unsigned char)*p) * 0x100000001B3ULL;
+    seed( h ^ mix(global_seed()) );
+  }
+
+  Random_stream( sc_dt::uint64 s ) { seed(s); }
+
+  static void set_global_seed( sc_dt::uint64 s ) { global_seed() = s; }
+
+  static sc_dt::uint64& global_seed()
+  {
+    static sc_dt::uint64 s = 0;
+    return s;
+  }
+
+  void seed( sc_dt::uint64 s )
+  {
+    // The state is expanded from the seed with splitmix64
+    for (int i = 0; i < 4; i++)
+      m_s[i] = mix( s += 0x9E3779B97F4A7C15ULL );
+  }
+
+  sc_dt::uint64 next()
+  {
+    sc_dt::uint64 result = rotl(m_s[1] * 5, 7) * 9;
+    sc_dt::uint64 t = m_s[1] << 17;
+    m_s[2] ^= m_s[0];
+    m_s[3] ^= m_s[1];
+    m_s[1] ^= m_s[2];
+    m_s[0] ^= m_s[3];
+    m_s[2] ^= t;
+    m_s[3] = rotl(m_s[3], 45);
+    return result;
+  }
+
+  // Uniform in [0, n), by Lemire's multiply and reject: the high word of r * n is
+  // uniform once the few r whose low word falls below 2^32 mod n are drawn again
+  unsigned int below( unsigned int n )
+  {
+    sc_dt::uint64 m = (next() >> 32) * n;
+    if ((unsigned int)m < n)
+    {
+      unsigned int threshold = (0u - n) % n;
+      while ((unsigned int)m < threshold)
+        m = (next() >> 32) * n;
+    }
+    return (unsigned int)(m >> 32);
+  }
+
+  // Uniform in [0, 1)
+  double uniform()
+  {
+    return (next() >> 11) * (1.0 / 9007199254740992.0);
+  }
+
+  void fill( void* buffer, std::size_t bytes )
+  {
+    unsigned char* p = static_cast<unsigned char*>(buffer);
+    for (; bytes >= 8; bytes -= 8, p += 8)
+    {
+      sc_dt::uint64 r = next();
+      memcpy( p, &r, 8 );
+    }
+    if (bytes)
+    {
+      sc_dt::uint64 r = next();
+      memcpy( p, &r, bytes );
+    }
+  }
+
+private:
+  static sc_dt::uint64 rotl( sc_dt::uint64 x, int k ) { return (x << k) | (x >> (64 - k)); }
+
+  static sc_dt::uint64 mix( sc_dt::uint64 z )
+  {
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+    return z ^ (z >> 31);
+  }
+
+  sc_dt::uint64 m_s[4];
+};
+
+
+struct Delay_distribution
+{
+  virtual ~Delay_distribution() {}
+
+  virtual sc_core::sc_time sample( Random_stream& random ) = 0;
+};
+
+struct Fixed_delay: Delay_distribution
+{
+  Fixed_delay( const sc_core::sc_time& delay ) : m_delay(delay) {}
+
+  sc_core::sc_time sample( Random_stream& ) { return m_delay; }
+
+  sc_core::sc_time m_delay;
+};
+
+struct Uniform_delay: Delay_distribution
+{
+  Uniform_delay( const sc_core::sc_time& min, const sc_core::sc_time& max )
+  : m_min(min), m_range(max > min ? max - min : sc_core::SC_ZERO_TIME) {}
+
+  sc_core::sc_time sample( Random_stream& random ) { return m_min + m_range * random.uniform(); }
+
+  sc_core::sc_time m_min;
+  sc_core::sc_time m_range;
+};
+
+// max * u^exponent for u uniform in [0, 1), so that larger exponents give shorter delays
+struct Power_law_delay: Delay_distribution
+{
+  Power_law_delay( const sc_core::sc_time& max, double exponent = 3 )
+  : m_max(max), m_exponent(exponent) {}
+
+  sc_core::sc_time sample( Random_stream& random )
+  {
+    double u = random.uniform();
+    return m_max * (m_exponent == 3 ? u * u * u : std::pow(u, m_exponent));
+  }
+
+  sc_core::sc_time m_max;
+  double           m_exponent;
+};
+
+// Picks one of the delays added, with probability proportional to its weight
+struct Empirical_delay: Delay_distribution
+{
+  void add( const sc_core::sc_time& delay, double weight = 1 )
+  {
+    m_delays.push_back(delay);
+    m_cumulative.push_back( (m_cumulative.empty() ? 0 : m_cumulative.back()) + weight );
+  }
+
+  sc_core::sc_time sample( Random_stream& random )
+  {
+    if (m_delays.empty())
+      return sc_core::SC_ZERO_TIME;
+    double x = random.uniform() * m_cumulative.back();
+    std::size_t i = std::upper_bound( m_cumulative.begin(), m_cumulative.end(), x ) - m_cumulative.begin();
+    return m_delays[ std::min(i, m_delays.size() - 1) ];
+  }
+
+  std::vector<sc_core::sc_time> m_delays;
+  std::vector<double>           m_cumulative;
+};
+
+#endif
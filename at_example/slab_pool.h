@@ -0,0 +1,247 @@
+
+// Filename: slab_pool.h
+
+//----------------------------------------------------------------------
+//  Licensed under the Apache License, Version 2.0 (the "License");
+//  you may not use this file except in compliance with the License.
+//  You may obtain a copy of the License at
+//
+//  http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+//----------------------------------------------------------------------
+
+// Version 1  16-Oct-2026
+// Version 2  16-Oct-2026  Data storage owned by each payload
+
+
+// *******************************************************************
+// Slab of generic payloads used by the memory managers
+// *******************************************************************
+
+/*
+Payloads are constructed in chunks of chunk_size, each chunk one contiguous array. Every
+payload is embedded in a slot that also holds the link of the free list, so returning a
+payload to the pool costs two pointer writes and no allocation.
+
+Payloads stay in the pool until the pool is destroyed. If a capacity is given, a warning is
+issued the first time more payloads than that are needed, and the pool then keeps growing.
+
+Each payload also owns data storage, returned by data(trans, length). Up to INLINE_BYTES are
+held inside the slot itself. Larger buffers come from a Buffer_arena, in power-of-two sizes,
+and stay attached to the payload when it is freed, so a recycled payload needs no new
+allocation unless it is asked for a larger buffer than before. An initiator can therefore
+have any number of transactions in flight, each with its own data, without touching the heap.
+*/
+
+#ifndef __SLAB_POOL_H__
+#define __SLAB_POOL_H__
+
+#include "tlm.h"
+
+#include <vector>
+#include <new>
+#include <sstream>
+#include <cstring>
+
+// Power-of-two sized buffers carved from large blocks. Freed buffers are kept on one free
+// list per size, linked through the buffers themselves
+class Buffer_arena
+{
+public:
+  static const unsigned int MIN_CLASS = 7;   // 128 bytes
+  static const unsigned int N_CLASSES = 32;
+
+  Buffer_arena( unsigned int block_size = 1 << 20 )
+  : m_block_size(block_size)
+  , m_next(0)
+  , m_left(0)
+  {
+    for (unsigned int c = 0; c < N_CLASSES; c++)
+      free_list[c] = 0;
+  }
+
+  ~Buffer_arena()
+  {
+    for (unsigned int b = 0; b < blocks.size(); b++)
+      ::operator delete( blocks[b] );
+  }
+
+  // A buffer of at least n bytes. On return, size is its actual size
+  unsigned char* get( unsigned int n, unsigned int& size )
+  {
+    unsigned int c = MIN_CLASS;
+    while ((1u << c) < n)
+      c++;
+    size = 1u << c;
+
+    if (free_list[c])
+    {
+      unsigned char* p = free_list[c];
+      memcpy( &free_list[c], p, sizeof(unsigned char*) );
+      return p;
+    }
+
+    if (size > m_block_size)
+      return new_block(size);
+
+    if (size > m_left)
+    {
+      m_next = new_block(m_block_size);
+      m_left = m_block_size;
+    }
+    unsigned char* p = m_next;
+    m_next += size;
+    m_left -= size;
+    return p;
+  }
+
+  void put( unsigned char* p, unsigned int size )
+  {
+    unsigned int c = MIN_CLASS;
+    while ((1u << c) < size)
+      c++;
+    memcpy( p, &free_list[c], sizeof(unsigned char*) );
+    free_list[c] = p;
+  }
+
+private:
+  unsigned char* new_block( unsigned int size )
+  {
+    unsigned char* p = static_cast<unsigned char*>( ::operator new(size) );
+    blocks.push_back(p);
+    return p;
+  }
+
+  unsigned int   m_block_size;
+  unsigned char* m_next;
+  unsigned int   m_left;
+  unsigned char* free_list[N_CLASSES];
+  std::vector<unsigned char*> blocks;
+};
+
+
+class Slab_pool
+{
+  typedef tlm::tlm_generic_payload gp_t;
+
+public:
+  static const unsigned int INLINE_BYTES = 64;
+
+  Slab_pool( tlm::tlm_mm_interface* owner, unsigned int capacity = 0, unsigned int chunk_size = 64 )
+  : m_owner(owner)
+  , m_capacity(capacity)
+  , m_chunk_size(chunk_size ? chunk_size : 1)
+  , m_size(0)
+  , m_warned(false)
+  , free_list(0)
+  {}
+
+  ~Slab_pool()
+  {
+    for (unsigned int c = 0; c < chunks.size(); c++)
+    {
+      for (unsigned int i = 0; i < chunk_len[c]; i++)
+        chunks[c][i].~slot();
+      ::operator delete( chunks[c] );
+    }
+  }
+
+  gp_t* get()
+  {
+    if (!free_list)
+      grow();
+
+    slot* s = free_list;
+    free_list = s->next;
+    return s;
+  }
+
+  // The payload must have come from get() on this pool
+  void put( gp_t* trans )
+  {
+    slot* s = static_cast<slot*>(trans);
+    s->next = free_list;
+    free_list = s;
+  }
+
+  // Data storage of at least length bytes owned by a payload from this pool. The contents
+  // are not preserved if a later call asks for more than the current buffer holds
+  unsigned char* data( gp_t* trans, unsigned int length )
+  {
+    slot* s = static_cast<slot*>(trans);
+    if (length <= INLINE_BYTES)
+      return reinterpret_cast<unsigned char*>(s->inline_data);
+
+    if (length > s->large_size)
+    {
+      if (s->large)
+        arena.put( s->large, s->large_size );
+      s->large = arena.get( length, s->large_size );
+    }
+    return s->large;
+  }
+
+  // Number of payloads constructed so far
+  unsigned int size() const { return m_size; }
+
+private:
+  struct slot: gp_t
+  {
+    slot( tlm::tlm_mm_interface* mm ) : gp_t(mm), next(0), large(0), large_size(0) {}
+
+    slot*          next;
+    unsigned char* large;
+    unsigned int   large_size;
+    sc_dt::uint64  inline_data[INLINE_BYTES / 8];
+  };
+
+  void grow()
+  {
+    unsigned int n = m_chunk_size;
+    if (m_capacity)
+    {
+      if (m_size >= m_capacity)
+      {
+        if (!m_warned)
+        {
+          std::ostringstream txt;
+          txt << "Transaction pool capacity of " << m_capacity << " payloads exhausted";
+          SC_REPORT_WARNING("Slab_pool", txt.str().c_str());
+          m_warned = true;
+        }
+      }
+      else if (n > m_capacity - m_size)
+        n = m_capacity - m_size;
+    }
+
+    slot* chunk = static_cast<slot*>( ::operator new( n * sizeof(slot) ) );
+    for (unsigned int i = 0; i < n; i++)
+    {
+      new (&chunk[i]) slot(m_owner);
+      chunk[i].next = (i + 1 < n) ? &chunk[i + 1] : free_list;
+    }
+    free_list = chunk;
+
+    chunks.push_back(chunk);
+    chunk_len.push_back(n);
+    m_size += n;
+  }
+
+  tlm::tlm_mm_interface* m_owner;
+  unsigned int m_capacity;
+  unsigned int m_chunk_size;
+  unsigned int m_size;
+  bool         m_warned;
+
+  slot* free_list;
+  std::vector<slot*>        chunks;
+  std::vector<unsigned int> chunk_len;
+  Buffer_arena              arena;
+};
+
+#endif
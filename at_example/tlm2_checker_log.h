@@ -0,0 +1,535 @@
+
+// Filename: tlm2_checker_log.h
+
+//----------------------------------------------------------------------
+//  Licensed under the Apache License, Version 2.0 (the "License");
+//  you may not use this file except in compliance with the License.
+//  You may obtain a copy of the License at
+//
+//  http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+//----------------------------------------------------------------------
+
+// Version 1  16-Oct-2026
+// Version 2  16-Oct-2026  Replay the calls of each process in a thread of its own
+
+
+// *******************************************************************
+// Offline protocol checking from a log of nb_transport and b_transport calls
+// *******************************************************************
+
+/*
+tlm2_logging_checker has the same sockets as tlm2_base_protocol_checker and is bound in
+the same places, but checks nothing. For every call and every return of nb_transport_fw,
+nb_transport_bw and b_transport it appends a 24-byte tlm2_event_record to the event log:
+the transaction, the hop (one per logging checker), the process making the call, the phase,
+the sync enum, the response status and sc_time_stamp() + delay. The log is written to disk
+by a background thread (see binary_log.h), so the simulation thread only pays for the copy
+into the ring.
+
+  tlm_utils::tlm2_event_log::instance().open("tlm2_events.bin");   // before sc_start
+  ...
+  tlm_utils::tlm2_event_log::instance().close();                   // after the run
+
+close() also writes the names of the logging checkers, one per line, to the file
+tlm2_events.bin.hops, and the names of the calling processes to tlm2_events.bin.processes.
+tools/checker_replay then rebuilds one tlm2_base_protocol_checker per hop and replays the
+log through them with tlm2_log_replayer.
+
+The calls of one process are nested, but those of different processes are not: a callee
+of b_transport may wait, and other processes then make and return calls of their own
+before it returns. The replayer therefore gives each logged process a thread of its own,
+which makes the calls of that process and waits while the log continues with the records
+of another. Calls are made in the order of the log and each process sees its own calls
+nested as they were, so every rule on the sequencing of phases, the exclusion rules, the
+timing annotations, the mixing of b_transport and nb_transport, the memory manager and the
+response path is checked as it would have been inline.
+
+The log holds no payload attributes or data, so the checks that an attribute or the data
+array was not modified during the lifetime of a transaction need the inline checker.
+DMI and debug calls are passed through without being logged.
+*/
+
+#ifndef __TLM2_CHECKER_LOG_H__
+#define __TLM2_CHECKER_LOG_H__
+
+#include "tlm2_base_protocol_checker.h"
+#include "binary_log.h"
+
+#include <string>
+#include <vector>
+#include <map>
+#include <fstream>
+
+namespace tlm_utils {
+
+
+struct tlm2_event_record
+{
+  enum event_t { FW_CALL, FW_RETURN, BW_CALL, BW_RETURN, B_CALL, B_RETURN };
+  enum { HAS_MM = 0x80 };   // Set in event if the transaction has a memory manager
+
+  sc_dt::uint64  id;        // Address of the transaction object
+  sc_dt::uint64  time;      // sc_time_stamp() + delay, in units of the time resolution
+  unsigned short hop;
+  unsigned short process;   // The calling process, numbered in the order of its first call
+  unsigned char  event;     // event_t, with the HAS_MM flag
+  unsigned char  phase;
+  unsigned char  status;    // tlm_sync_enum, on returns
+  signed char    response;  // tlm_response_status
+
+  event_t kind() const { return event_t(event & ~HAS_MM); }
+};
+
+
+class tlm2_event_log
+{
+public:
+  static tlm2_event_log& instance()
+  {
+    static tlm2_event_log log;
+    return log;
+  }
+
+  ~tlm2_event_log() { close(); }
+
+  bool open( const std::string& filename )
+  {
+    m_filename = filename;
+    return m_log.open( filename.c_str(), "TLM2EVT" );
+  }
+
+  void close()
+  {
+    if (!m_log.is_open())
+      return;
+    m_log.close();
+
+    std::ofstream hops( (m_filename + ".hops").c_str() );
+    for (unsigned int i = 0; i < m_hops.size(); i++)
+      hops << m_hops[i] << "\n";
+
+    std::ofstream processes( (m_filename + ".processes").c_str() );
+    for (unsigned int i = 0; i < m_processes.size(); i++)
+      processes << m_processes[i] << "\n";
+  }
+
+  bool is_open() const { return m_log.is_open(); }
+
+  unsigned int add_hop( const char* name )
+  {
+    m_hops.push_back(name);
+    return m_hops.size() - 1;
+  }
+
+  void record( unsigned int hop, tlm2_event_record::event_t event, tlm::tlm_generic_payload& trans,
+               const tlm::tlm_phase& phase, tlm::tlm_sync_enum status, const sc_core::sc_time& delay )
+  {
+    if (!m_log.is_open())
+      return;
+
+    tlm2_event_record r;
+    r.id       = (sc_dt::uint64)reinterpret_cast<std::size_t>(&trans);
+    r.time     = (sc_core::sc_time_stamp() + delay).value();
+    r.hop      = hop;
+    r.process  = process_id();
+    r.event    = event | (trans.has_mm() ? tlm2_event_record::HAS_MM : 0);
+    r.phase    = (unsigned int)phase;
+    r.status   = status;
+    r.response = trans.get_response_status();
+    m_log.append(r);
+  }
+
+  sc_dt::uint64 written() const { return m_log.written(); }
+
+private:
+  tlm2_event_log() : m_last_process(0), m_last_process_id(0) {}
+
+  unsigned short process_id()
+  {
+    const sc_core::sc_object* process = sc_core::sc_get_current_process_handle().get_process_object();
+    if (process == m_last_process && !m_processes.empty())
+      return m_last_process_id;
+
+    std::map<const sc_core::sc_object*, unsigned short>::iterator it = m_process_ids.find(process);
+    if (it == m_process_ids.end())
+    {
+      if (m_processes.size() > 0xFFFF)
+        SC_REPORT_FATAL("tlm2_event_log", "Too many processes for the event log");
+      it = m_process_ids.insert( std::make_pair(process, (unsigned short)m_processes.size()) ).first;
+      m_processes.push_back( process ? process->name() : "none" );
+    }
+    m_last_process    = process;
+    m_last_process_id = it->second;
+    return m_last_process_id;
+  }
+
+  Binary_log<tlm2_event_record> m_log;
+  std::string                   m_filename;
+  std::vector<std::string>      m_hops;
+  std::vector<std::string>      m_processes;
+  std::map<const sc_core::sc_object*, unsigned short> m_process_ids;
+  const sc_core::sc_object*     m_last_process;
+  unsigned short                m_last_process_id;
+};
+
+
+// ******************** LOGGING CHECKER ********************
+
+
+template <unsigned int BUSWIDTH = 32>
+class tlm2_logging_checker
+
+: public sc_core::sc_module
+, public tlm::tlm_fw_transport_if<tlm::tlm_base_protocol_types>
+, public tlm::tlm_bw_transport_if<tlm::tlm_base_protocol_types>
+{
+public:
+
+  tlm::tlm_target_socket   <BUSWIDTH, tlm::tlm_base_protocol_types, 1> target_socket;
+  tlm::tlm_initiator_socket<BUSWIDTH, tlm::tlm_base_protocol_types, 1> initiator_socket;
+
+  SC_CTOR(tlm2_logging_checker)
+  : m_log(tlm2_event_log::instance())
+  {
+    target_socket   .bind( *this );
+    initiator_socket.bind( *this );
+    m_hop = m_log.add_hop( name() );
+  }
+
+  virtual tlm::tlm_sync_enum nb_transport_fw(
+    tlm::tlm_generic_payload& trans, tlm::tlm_phase& phase, sc_core::sc_time& delay)
+  {
+    m_log.record( m_hop, tlm2_event_record::FW_CALL, trans, phase, tlm::TLM_ACCEPTED, delay );
+    tlm::tlm_sync_enum status = initiator_socket->nb_transport_fw( trans, phase, delay );
+    m_log.record( m_hop, tlm2_event_record::FW_RETURN, trans, phase, status, delay );
+    return status;
+  }
+
+  virtual tlm::tlm_sync_enum nb_transport_bw(
+    tlm::tlm_generic_payload& trans, tlm::tlm_phase& phase, sc_core::sc_time& delay)
+  {
+    m_log.record( m_hop, tlm2_event_record::BW_CALL, trans, phase, tlm::TLM_ACCEPTED, delay );
+    tlm::tlm_sync_enum status = target_socket->nb_transport_bw( trans, phase, delay );
+    m_log.record( m_hop, tlm2_event_record::BW_RETURN, trans, phase, status, delay );
+    return status;
+  }
+
+  virtual void b_transport( tlm::tlm_generic_payload& trans, sc_core::sc_time& delay )
+  {
+    m_log.record( m_hop, tlm2_event_record::B_CALL, trans, tlm::UNINITIALIZED_PHASE,
+                  tlm::TLM_COMPLETED, delay );
+    initiator_socket->b_transport( trans, delay );
+    m_log.record( m_hop, tlm2_event_record::B_RETURN, trans, tlm::UNINITIALIZED_PHASE,
+                  tlm::TLM_COMPLETED, delay );
+  }
+
+  virtual bool get_direct_mem_ptr(tlm::tlm_generic_payload& trans, tlm::tlm_dmi& dmi_data)
+  {
+    return initiator_socket->get_direct_mem_ptr( trans, dmi_data );
+  }
+
+  virtual void invalidate_direct_mem_ptr(sc_dt::uint64 start_range, sc_dt::uint64 end_range)
+  {
+    target_socket->invalidate_direct_mem_ptr( start_range, end_range );
+  }
+
+  virtual unsigned int transport_dbg(tlm::tlm_generic_payload& trans)
+  {
+    return initiator_socket->transport_dbg( trans );
+  }
+
+private:
+  tlm2_event_log& m_log;
+  unsigned int    m_hop;
+};
+
+
+// ******************** REPLAY ********************
+
+
+class tlm2_log_replayer;
+
+// Stands in for the initiator and the target on either side of one checker during replay
+struct tlm2_replay_endpoint
+
+: public sc_core::sc_module
+, public tlm::tlm_fw_transport_if<tlm::tlm_base_protocol_types>
+, public tlm::tlm_bw_transport_if<tlm::tlm_base_protocol_types>
+{
+  tlm::tlm_initiator_socket<32, tlm::tlm_base_protocol_types, 1> init_socket;
+  tlm::tlm_target_socket   <32, tlm::tlm_base_protocol_types, 1> targ_socket;
+
+  tlm2_replay_endpoint( sc_core::sc_module_name name, tlm2_log_replayer& r, unsigned int h )
+  : sc_core::sc_module(name)
+  , replayer(r)
+  , hop(h)
+  {
+    init_socket.bind( *this );
+    targ_socket.bind( *this );
+  }
+
+  virtual tlm::tlm_sync_enum nb_transport_fw(
+    tlm::tlm_generic_payload& trans, tlm::tlm_phase& phase, sc_core::sc_time& delay);
+
+  virtual tlm::tlm_sync_enum nb_transport_bw(
+    tlm::tlm_generic_payload& trans, tlm::tlm_phase& phase, sc_core::sc_time& delay);
+
+  virtual void b_transport( tlm::tlm_generic_payload& trans, sc_core::sc_time& delay );
+
+  virtual bool get_direct_mem_ptr(tlm::tlm_generic_payload&, tlm::tlm_dmi&) { return false; }
+  virtual void invalidate_direct_mem_ptr(sc_dt::uint64, sc_dt::uint64) {}
+  virtual unsigned int transport_dbg(tlm::tlm_generic_payload&) { return 0; }
+
+  tlm2_log_replayer& replayer;
+  unsigned int       hop;
+};
+
+
+// Makes the calls of one logged process during replay
+struct tlm2_replay_process: public sc_core::sc_module
+{
+  SC_HAS_PROCESS(tlm2_replay_process);
+
+  tlm2_replay_process( sc_core::sc_module_name name, tlm2_log_replayer& r, unsigned int p )
+  : sc_core::sc_module(name)
+  , replayer(r)
+  , process(p)
+  {
+    SC_THREAD(thread_process);
+  }
+
+  void thread_process();
+
+  tlm2_log_replayer& replayer;
+  unsigned int       process;
+  sc_core::sc_event  turn;     // Notified when the next record in the log is of this process
+};
+
+
+// Replays an event log through one tlm2_base_protocol_checker per hop. Each call record is
+// made as a real call into the checker of its hop, from the thread of its process, and the
+// endpoint on the far side of the checker replays the records of that process nested in the
+// call until it reaches the matching return, whose phase, delay and sync enum it returns
+class tlm2_log_replayer: public sc_core::sc_module
+{
+public:
+  tlm2_log_replayer( sc_core::sc_module_name name, const std::string& filename )
+  : sc_core::sc_module(name)
+  , records(0)
+  , m_more(false)
+  , m_running(0)
+  {
+    if (!m_reader.open( filename.c_str(), "TLM2EVT" ))
+      SC_REPORT_FATAL("tlm2_log_replayer", ("Cannot read event log " + filename).c_str());
+
+    std::ifstream hops( (filename + ".hops").c_str() );
+    std::string hop_name;
+    while (std::getline(hops, hop_name))
+    {
+      // The checkers keep the names of the originals, flattened into one level
+      flatten( hop_name );
+
+      unsigned int h = checkers.size();
+      checkers.push_back( new tlm2_base_protocol_checker<32>( hop_name.c_str() ) );
+      endpoints.push_back( new tlm2_replay_endpoint( (hop_name + "_endpoint").c_str(), *this, h ) );
+
+      endpoints[h]->init_socket.bind( checkers[h]->target_socket );
+      checkers[h]->initiator_socket.bind( endpoints[h]->targ_socket );
+    }
+    if (checkers.empty())
+      SC_REPORT_FATAL("tlm2_log_replayer", ("No hops listed in " + filename + ".hops").c_str());
+
+    std::ifstream names( (filename + ".processes").c_str() );
+    std::string process_name;
+    while (std::getline(names, process_name))
+    {
+      flatten( process_name );
+      processes.push_back( new tlm2_replay_process( (process_name + "_replay").c_str(), *this,
+                                                    processes.size() ) );
+    }
+    if (processes.empty())
+      SC_REPORT_FATAL("tlm2_log_replayer", ("No processes listed in " + filename + ".processes").c_str());
+
+    read_next();
+  }
+
+  // Replays the records of process p that are not nested in a call
+  void run( unsigned int p )
+  {
+    tlm2_event_record r;
+    while (take(p, r))
+      play(r);
+  }
+
+  // Replays the records of the running process nested in a call, until the return of the
+  // given kind from the given hop
+  tlm::tlm_sync_enum play_until( unsigned int hop, tlm2_event_record::event_t event,
+                                 tlm::tlm_generic_payload& trans, tlm::tlm_phase& phase,
+                                 sc_core::sc_time& delay )
+  {
+    unsigned int p = m_running;
+    tlm2_event_record r;
+    while (take(p, r))
+    {
+      if (r.kind() == event && r.hop == hop && &payload(r) == &trans)
+      {
+        phase = tlm::tlm_phase( (unsigned int)r.phase );
+        delay = sc_core::sc_time::from_value( r.time );
+        trans.set_response_status( tlm::tlm_response_status(r.response) );
+        return tlm::tlm_sync_enum(r.status);
+      }
+      play(r);
+    }
+    SC_REPORT_ERROR("tlm2_log_replayer", "Event log ends inside a call");
+    return tlm::TLM_COMPLETED;
+  }
+
+  sc_dt::uint64 records;
+
+private:
+  struct null_mm: tlm::tlm_mm_interface
+  {
+    void free(tlm::tlm_generic_payload*) {}
+  };
+
+  static void flatten( std::string& name )
+  {
+    for (unsigned int i = 0; i < name.size(); i++)
+      if (name[i] == '.')
+        name[i] = '_';
+  }
+
+  // Reads the next record into m_next, skipping records of processes not listed
+  void read_next()
+  {
+    while ((m_more = m_reader.next(m_next)) && m_next.process >= processes.size())
+      SC_REPORT_ERROR("tlm2_log_replayer", "Event log refers to an unknown process");
+  }
+
+  // Waits until the next record in the log is of process p and takes it.
+  // Returns false at the end of the log
+  bool take( unsigned int p, tlm2_event_record& r )
+  {
+    while (m_more && m_next.process != p)
+      sc_core::wait( processes[p]->turn );
+    m_running = p;
+    if (!m_more)
+      return false;
+
+    r = m_next;
+    records++;
+    read_next();
+
+    // Wake the process of the next record, or at the end every process, to finish
+    if (!m_more)
+      for (unsigned int i = 0; i < processes.size(); i++)
+        processes[i]->turn.notify( sc_core::SC_ZERO_TIME );
+    else if (m_next.process != p)
+      processes[m_next.process]->turn.notify( sc_core::SC_ZERO_TIME );
+    return true;
+  }
+
+  void play( const tlm2_event_record& r )
+  {
+    if (r.hop >= checkers.size())
+    {
+      SC_REPORT_ERROR("tlm2_log_replayer", "Event log refers to an unknown hop");
+      return;
+    }
+
+    tlm::tlm_generic_payload& trans = payload(r);
+    tlm::tlm_phase   phase( (unsigned int)r.phase );
+    sc_core::sc_time delay = sc_core::sc_time::from_value( r.time );
+    trans.set_response_status( tlm::tlm_response_status(r.response) );
+
+    switch (r.kind())
+    {
+      case tlm2_event_record::FW_CALL:
+        endpoints[r.hop]->init_socket->nb_transport_fw( trans, phase, delay );
+        break;
+      case tlm2_event_record::BW_CALL:
+        endpoints[r.hop]->targ_socket->nb_transport_bw( trans, phase, delay );
+        break;
+      case tlm2_event_record::B_CALL:
+        endpoints[r.hop]->init_socket->b_transport( trans, delay );
+        break;
+      default:
+        SC_REPORT_ERROR("tlm2_log_replayer", "Return in event log without a matching call");
+    }
+  }
+
+  // The stand-in for a logged transaction object, with valid initial attributes
+  tlm::tlm_generic_payload& payload( const tlm2_event_record& r )
+  {
+    tlm::tlm_generic_payload*& trans = m_payloads[ reinterpret_cast<const void*>( (std::size_t)r.id ) ];
+    if (!trans)
+    {
+      trans = new tlm::tlm_generic_payload;
+      trans->set_command( tlm::TLM_READ_COMMAND );
+      trans->set_address( 0 );
+      trans->set_data_ptr( reinterpret_cast<unsigned char*>(&m_data) );
+      trans->set_data_length( sizeof(m_data) );
+      trans->set_streaming_width( sizeof(m_data) );
+      trans->set_byte_enable_ptr( 0 );
+      trans->set_dmi_allowed( false );
+    }
+
+    if (r.event & tlm2_event_record::HAS_MM)
+    {
+      if (!trans->has_mm())
+        trans->set_mm( &m_mm );
+      if (trans->get_ref_count() == 0)
+        trans->acquire();
+    }
+    else
+      trans->set_mm( 0 );
+    return *trans;
+  }
+
+  std::vector<tlm2_base_protocol_checker<32>*> checkers;
+  std::vector<tlm2_replay_endpoint*>           endpoints;
+  std::vector<tlm2_replay_process*>            processes;
+
+  Binary_log_reader<tlm2_event_record>  m_reader;
+  tlm2_event_record                     m_next;     // The record at the head of the log
+  bool                                  m_more;     // False once the log is exhausted
+  unsigned int                          m_running;  // The process whose thread is running
+  trans_map<tlm::tlm_generic_payload*>  m_payloads;
+  null_mm                               m_mm;
+  int                                   m_data;
+};
+
+
+inline void tlm2_replay_process::thread_process()
+{
+  replayer.run( process );
+}
+
+inline tlm::tlm_sync_enum tlm2_replay_endpoint::nb_transport_fw(
+  tlm::tlm_generic_payload& trans, tlm::tlm_phase& phase, sc_core::sc_time& delay)
+{
+  return replayer.play_until( hop, tlm2_event_record::FW_RETURN, trans, phase, delay );
+}
+
+inline tlm::tlm_sync_enum tlm2_replay_endpoint::nb_transport_bw(
+  tlm::tlm_generic_payload& trans, tlm::tlm_phase& phase, sc_core::sc_time& delay)
+{
+  return replayer.play_until( hop, tlm2_event_record::BW_RETURN, trans, phase, delay );
+}
+
+inline void tlm2_replay_endpoint::b_transport( tlm::tlm_generic_payload& trans, sc_core::sc_time& delay )
+{
+  tlm::tlm_phase phase;
+  replayer.play_until( hop, tlm2_event_record::B_RETURN, trans, phase, delay );
+}
+
+
+} // namespace tlm_utils
+
+#endif
@@ -0,0 +1,166 @@
+
+// Filename: trace_file.h
+
+//----------------------------------------------------------------------
+//  Licensed under the Apache License, Version 2.0 (the "License");
+//  you may not use this file except in compliance with the License.
+//  You may obtain a copy of the License at
+//
+//  http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+//----------------------------------------------------------------------
+
+// Version 1  16-Oct-2026
+
+
+// *******************************************************************
+// Compact binary memory-access trace, read through a memory mapping
+// *******************************************************************
+
+/*
+A trace is a file of 16-byte Trace_records behind the same header as a Binary_log (see
+binary_log.h), with the magic "TLMTRACE". Each record holds the address, size and command
+of one access and the time since the previous access in picoseconds. A gap too long for
+32 bits is carried by IDLE records, which only advance the time. tools/trace_convert
+writes a trace from a text file.
+
+Trace_file maps the whole trace read-only and hands out the records in order with next().
+The mapping is advised as sequential, and the file is prefetched in chunks: on entering a
+chunk the next one is requested with MADV_WILLNEED, so that the kernel reads it in while
+the current one is replayed, and chunks already replayed are released, so that the
+resident set stays at a few chunks whatever the length of the trace.
+*/
+
+#ifndef __TRACE_FILE_H__
+#define __TRACE_FILE_H__
+
+#include "systemc"
+
+#include <cstring>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+struct Trace_record
+{
+  enum command_t { READ, WRITE, IDLE };
+
+  sc_dt::uint64  address;
+  unsigned int   gap;       // Picoseconds since the previous record
+  unsigned short size;      // Bytes
+  unsigned char  command;
+  unsigned char  reserved;
+};
+
+
+class Trace_file
+{
+public:
+  static const unsigned int header_bytes = 12;   // Magic and record size, as Binary_log
+
+  Trace_file( sc_dt::uint64 chunk = 16 << 20 )
+  : m_base(0), m_bytes(0), m_n(0), m_next(0)
+  {
+    // madvise works on whole pages
+    m_chunk = chunk < 4096 ? 4096 : (chunk + 4095) & ~sc_dt::uint64(4095);
+  }
+
+  ~Trace_file() { close(); }
+
+  // Fails if the file cannot be mapped or is not a trace
+  bool open( const char* filename )
+  {
+    close();
+    int fd = ::open( filename, O_RDONLY );
+    if (fd < 0)
+      return false;
+
+    struct stat st;
+    if (fstat( fd, &st ) != 0 || sc_dt::uint64(st.st_size) < header_bytes)
+    {
+      ::close( fd );
+      return false;
+    }
+    m_bytes = st.st_size;
+
+    void* p = mmap( 0, m_bytes, PROT_READ, MAP_PRIVATE, fd, 0 );
+    ::close( fd );
+    if (p == MAP_FAILED)
+      return false;
+    m_base = static_cast<const unsigned char*>(p);
+
+    char magic[8] = { 'T', 'L', 'M', 'T', 'R', 'A', 'C', 'E' };
+    unsigned int size;
+    memcpy( &size, m_base + 8, sizeof(size) );
+    if (memcmp( m_base, magic, sizeof(magic) ) != 0 || size != sizeof(Trace_record))
+    {
+      close();
+      return false;
+    }
+
+    m_n = (m_bytes - header_bytes) / sizeof(Trace_record);
+    madvise( mapped(0), m_bytes, MADV_SEQUENTIAL );
+    rewind();
+    return true;
+  }
+
+  void close()
+  {
+    if (m_base)
+      munmap( mapped(0), m_bytes );
+    m_base = 0;
+    m_n    = 0;
+  }
+
+  bool is_open() const { return m_base != 0; }
+
+  // Number of records in the trace
+  sc_dt::uint64 size() const { return m_n; }
+
+  void rewind() { m_next = 0; }
+
+  bool next( Trace_record& r )
+  {
+    if (m_next == m_n)
+      return false;
+
+    sc_dt::uint64 offset = header_bytes + m_next * sizeof(Trace_record);
+    if (offset % m_chunk < sizeof(Trace_record))
+      prefetch( offset / m_chunk );
+
+    // The records are not aligned in the file, so each is copied out
+    memcpy( &r, m_base + offset, sizeof(r) );
+    m_next++;
+    return true;
+  }
+
+private:
+  void* mapped( sc_dt::uint64 offset ) const { return const_cast<unsigned char*>(m_base) + offset; }
+
+  // Ask for the chunk after this one and drop the one before
+  void prefetch( sc_dt::uint64 chunk )
+  {
+    sc_dt::uint64 ahead = (chunk + 1) * m_chunk;
+    if (chunk == 0)
+      madvise( mapped(0), m_bytes < 2 * m_chunk ? m_bytes : 2 * m_chunk, MADV_WILLNEED );
+    else if (ahead < m_bytes)
+      madvise( mapped(ahead), m_bytes - ahead < m_chunk ? m_bytes - ahead : m_chunk, MADV_WILLNEED );
+
+    if (chunk > 1)
+      madvise( mapped((chunk - 2) * m_chunk), m_chunk, MADV_DONTNEED );
+  }
+
+  const unsigned char* m_base;
+  sc_dt::uint64        m_bytes;
+  sc_dt::uint64        m_n;
+  sc_dt::uint64        m_next;
+  sc_dt::uint64        m_chunk;
+};
+
+#endif
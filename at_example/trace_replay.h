@@ -0,0 +1,120 @@
+
+// Filename: trace_replay.h
+
+//----------------------------------------------------------------------
+//  Licensed under the Apache License, Version 2.0 (the "License");
+//  you may not use this file except in compliance with the License.
+//  You may obtain a copy of the License at
+//
+//  http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+//----------------------------------------------------------------------
+
+// Version 1  16-Oct-2026
+// Version 2  16-Oct-2026  Issue through Initiator_engine
+
+
+// *******************************************************************
+// Initiator replaying a memory-access trace
+// *******************************************************************
+
+/*
+Trace_replay issues the accesses of a binary trace (see trace_file.h) in order, through
+nb_transport_fw (AT) or b_transport (LT). By default each request is issued at the time
+recorded in the trace, relative to the start of simulation. With set_rate() the recorded
+times are ignored and the trace is replayed open loop at a fixed number of requests per
+microsecond.
+
+A request is never issued before its time, but may be late when the outstanding limit or
+the BEGIN_REQ/END_REQ exclusion rule holds it back. The requests after it keep their own
+times, so the replay catches up as soon as the system allows, and max_lag records how far
+behind the trace the replay fell. LT replays one request at a time.
+*/
+
+#ifndef __TRACE_REPLAY_H__
+#define __TRACE_REPLAY_H__
+
+#include "common_header.h"
+#include "initiator_engine.h"
+#include "trace_file.h"
+
+#include <string>
+
+struct Trace_replay: Initiator_engine
+{
+  SC_HAS_PROCESS(Trace_replay);
+
+  Trace_replay( sc_module_name name, const char* filename, protocol_t protocol = AT )
+  : Initiator_engine(name, protocol)
+  , max_lag(SC_ZERO_TIME)
+  , m_interval(SC_ZERO_TIME)
+  , m_outstanding(0)
+  {
+    if (!m_trace.open(filename))
+    {
+      std::string txt = std::string("Cannot open trace file ") + filename;
+      SC_REPORT_FATAL(this->name(), txt.c_str());
+    }
+
+    SC_THREAD(thread_process);
+  }
+
+  // Replay open loop at this many requests per microsecond, or at the recorded times if 0
+  void set_rate( double per_us )
+  {
+    m_interval = per_us > 0 ? sc_time(1000 / per_us, SC_NS) : SC_ZERO_TIME;
+  }
+
+  // Most requests issued but not yet responded to (0 = no limit)
+  void set_outstanding( unsigned int n ) { m_outstanding = n; }
+
+  sc_dt::uint64 trace_size() const { return m_trace.size(); }
+
+  void thread_process()
+  {
+    sc_time start = sc_time_stamp();
+    sc_time due = start;
+    sc_dt::uint64 trace_ps = 0;
+    Trace_record r;
+
+    while (m_trace.next(r))
+    {
+      trace_ps += r.gap;
+      if (m_interval == SC_ZERO_TIME)
+        due = start + sc_time( double(trace_ps), SC_PS );
+      if (r.command == Trace_record::IDLE)
+        continue;
+
+      if (due > sc_time_stamp())
+        wait( due - sc_time_stamp() );
+
+      wait_for_slot( m_outstanding );
+
+      if (sc_time_stamp() - due > max_lag)
+        max_lag = sc_time_stamp() - due;
+
+      tlm::tlm_generic_payload* trans = allocate(
+        r.command == Trace_record::WRITE ? tlm::TLM_WRITE_COMMAND : tlm::TLM_READ_COMMAND,
+        r.address, r.size );
+      issue( *trans );
+
+      if (m_interval != SC_ZERO_TIME)
+        due += m_interval;
+    }
+  }
+
+  // How far behind the trace the replay fell
+  sc_time       max_lag;
+
+private:
+  Trace_file    m_trace;
+  sc_time       m_interval;
+  unsigned int  m_outstanding;
+};
+
+#endif
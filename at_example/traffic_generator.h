@@ -0,0 +1,359 @@
+
+// Filename: traffic_generator.h
+
+//----------------------------------------------------------------------
+//  Licensed under the Apache License, Version 2.0 (the "License");
+//  you may not use this file except in compliance with the License.
+//  You may obtain a copy of the License at
+//
+//  http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+//----------------------------------------------------------------------
+
+// Version 1  16-Oct-2026
+// Version 2  16-Oct-2026  Issue through Initiator_engine
+
+
+// *******************************************************************
+// Configurable traffic generator, for benchmarking interconnects and targets
+// *******************************************************************
+
+/*
+Traffic_generator is an initiator whose traffic is described by a Traffic_config:
+
+  protocol       at | lt                    nb_transport_fw, or b_transport then wait
+  pattern        sequential | strided | random | hot_spot | pointer_chase
+  base, span     the addresses used are [base, base + span), aligned to size
+  stride         bytes between the addresses of the strided pattern
+  hot_base       hot_spot sends hot_fraction of the requests to [hot_base, hot_base + hot_span)
+  hot_span       and the rest to the whole range
+  hot_fraction
+  size           bytes per transaction
+  read_fraction  0 for writes only, 1 for reads only
+  interval_ns    the injection rate, as the time between requests (0 = as fast as possible)
+  rate           the injection rate, as requests per microsecond (sets interval_ns)
+  outstanding    most requests issued but not yet responded to (0 = no limit, AT only)
+  n_trans        run length in transactions (0 = no limit)
+  duration_ns    run length in simulated time (0 = no limit)
+
+Numbers are decimal or 0x-prefixed hex. The config is read from a text file with load(),
+one "key = value" per line with # comments, or from command line arguments of the form
+key=value with parse_args(). An argument without an '=' names a config file to load, so
+
+  out traffic.cfg pattern=strided stride=256
+
+reads traffic.cfg then overrides two of its settings. A program with settings of its own
+derives from Traffic_config and overrides parse(), passing on the keys it does not know.
+
+Requests are issued at the injection rate for as long as the outstanding limit allows, and
+a request held back by the limit is issued as soon as a response arrives, so that the rate
+is kept up over the run where the system can sustain it. The pointer_chase pattern models
+a walk down a linked list, in which each address would come from the data returned by the
+previous read: one request is outstanding at a time, and the addresses follow a random
+cycle through every slot of the largest power-of-two number of slots that fits in the
+span. LT is also one request at a time, since b_transport blocks.
+*/
+
+#ifndef __TRAFFIC_GENERATOR_H__
+#define __TRAFFIC_GENERATOR_H__
+
+#include "common_header.h"
+#include "initiator_engine.h"
+
+#include <string>
+#include <sstream>
+#include <algorithm>
+#include <cstring>
+#include <cstdlib>
+
+struct Traffic_config
+{
+  enum pattern_t  { SEQUENTIAL, STRIDED, RANDOM, HOT_SPOT, POINTER_CHASE };
+  typedef Initiator_engine::protocol_t protocol_t;
+
+  Traffic_config()
+  : protocol(Initiator_engine::AT)
+  , pattern(RANDOM)
+  , base(0)
+  , span(0x10000)
+  , stride(64)
+  , hot_base(0)
+  , hot_span(0x1000)
+  , hot_fraction(0.9)
+  , size(4)
+  , read_fraction(0.5)
+  , interval(SC_ZERO_TIME)
+  , outstanding(1)
+  , n_trans(1000)
+  , duration(SC_ZERO_TIME)
+  {}
+
+  virtual ~Traffic_config() {}
+
+  // Returns false if the key is unknown
+  virtual bool parse( const std::string& key, const std::string& value )
+  {
+    static const char* protocols[] = { "at", "lt", 0 };
+    static const char* patterns[]  = { "sequential", "strided", "random", "hot_spot", "pointer_chase", 0 };
+
+    if      (key == "protocol")      protocol      = protocol_t( choice(key, value, protocols) );
+    else if (key == "pattern")       pattern       = pattern_t( choice(key, value, patterns) );
+    else if (key == "base")          base          = number(key, value);
+    else if (key == "span")          span          = number(key, value);
+    else if (key == "stride")        stride        = number(key, value);
+    else if (key == "hot_base")      hot_base      = number(key, value);
+    else if (key == "hot_span")      hot_span      = number(key, value);
+    else if (key == "hot_fraction")  hot_fraction  = real(key, value);
+    else if (key == "size")          size          = (unsigned int)number(key, value);
+    else if (key == "read_fraction") read_fraction = real(key, value);
+    else if (key == "interval_ns")   interval      = sc_time(real(key, value), SC_NS);
+    else if (key == "rate")
+    {
+      double r = real(key, value);
+      interval = r > 0 ? sc_time(1000 / r, SC_NS) : SC_ZERO_TIME;
+    }
+    else if (key == "outstanding")   outstanding   = (unsigned int)number(key, value);
+    else if (key == "n_trans")       n_trans       = number(key, value);
+    else if (key == "duration_ns")   duration      = sc_time(real(key, value), SC_NS);
+    else
+      return false;
+    return true;
+  }
+
+  // Read settings from a text file. Returns false if the file cannot be opened
+  bool load( const char* filename )
+  {
+    std::ifstream in(filename);
+    if (!in)
+      return false;
+
+    std::string line;
+    unsigned int line_nr = 0;
+    while (std::getline(in, line))
+    {
+      line_nr++;
+      std::string::size_type hash = line.find('#');
+      if (hash != std::string::npos)
+        line.erase(hash);
+      std::replace(line.begin(), line.end(), '=', ' ');
+
+      std::istringstream fields(line);
+      std::string key, value, extra;
+      if (!(fields >> key))
+        continue;
+      if (!(fields >> value) || (fields >> extra) || !parse(key, value))
+      {
+        std::ostringstream txt;
+        txt << filename << ":" << line_nr << ": expected <key> = <value>, with a known key";
+        SC_REPORT_FATAL("Traffic_config", txt.str().c_str());
+      }
+    }
+    return true;
+  }
+
+  // Apply key=value arguments in order, loading any argument without an '=' as a config file
+  void parse_args( int argc, char* argv[], int first = 1 )
+  {
+    for (int i = first; i < argc; i++)
+    {
+      std::string arg = argv[i];
+      std::string::size_type eq = arg.find('=');
+      std::string txt;
+
+      if (eq == std::string::npos)
+      {
+        if (!load(argv[i]))
+          txt = "Cannot open config file " + arg;
+      }
+      else if (!parse( arg.substr(0, eq), arg.substr(eq + 1) ))
+        txt = "Unknown setting " + arg;
+
+      if (!txt.empty())
+        SC_REPORT_FATAL("Traffic_config", txt.c_str());
+    }
+  }
+
+  // Reports a fatal error for a config that cannot be run
+  void check( const char* name ) const
+  {
+    std::ostringstream txt;
+    if (size == 0)
+      txt << "size must not be 0";
+    else if (span < size)
+      txt << "span " << span << " is smaller than size " << size;
+    else if (pattern == HOT_SPOT && hot_span < size)
+      txt << "hot_span " << hot_span << " is smaller than size " << size;
+    else if (read_fraction < 0 || read_fraction > 1)
+      txt << "read_fraction must lie between 0 and 1";
+    else if (n_trans == 0 && duration == SC_ZERO_TIME)
+      txt << "n_trans or duration_ns must limit the run";
+
+    if (!txt.str().empty())
+      SC_REPORT_FATAL(name, txt.str().c_str());
+  }
+
+  protocol_t    protocol;
+  pattern_t     pattern;
+  sc_dt::uint64 base;
+  sc_dt::uint64 span;
+  sc_dt::uint64 stride;
+  sc_dt::uint64 hot_base;
+  sc_dt::uint64 hot_span;
+  double        hot_fraction;
+  unsigned int  size;
+  double        read_fraction;
+  sc_time       interval;
+  unsigned int  outstanding;
+  sc_dt::uint64 n_trans;
+  sc_time       duration;
+
+private:
+  static sc_dt::uint64 number( const std::string& key, const std::string& value )
+  {
+    char* end;
+    sc_dt::uint64 n = strtoull(value.c_str(), &end, 0);
+    if (value.empty() || *end)
+      bad_value(key, value);
+    return n;
+  }
+
+  static double real( const std::string& key, const std::string& value )
+  {
+    char* end;
+    double d = strtod(value.c_str(), &end);
+    if (value.empty() || *end)
+      bad_value(key, value);
+    return d;
+  }
+
+  static unsigned int choice( const std::string& key, const std::string& value, const char* names[] )
+  {
+    for (unsigned int i = 0; names[i]; i++)
+      if (value == names[i])
+        return i;
+    bad_value(key, value);
+    return 0;
+  }
+
+  static void bad_value( const std::string& key, const std::string& value )
+  {
+    std::string txt = "Bad value " + value + " for " + key;
+    SC_REPORT_FATAL("Traffic_config", txt.c_str());
+  }
+};
+
+
+struct Traffic_generator: Initiator_engine
+{
+  SC_HAS_PROCESS(Traffic_generator);
+
+  Traffic_generator( sc_module_name name, const Traffic_config& config )
+  : Initiator_engine(name, config.protocol)
+  , cfg(config)
+  , m_chase(0)
+  , m_chase_bits(0)
+  , m_random(this->name())
+  {
+    cfg.check(this->name());
+
+    while (m_chase_bits < 63 && (cfg.span / cfg.size) >> (m_chase_bits + 1))
+      m_chase_bits++;
+
+    SC_THREAD(thread_process);
+  }
+
+  void thread_process()
+  {
+    sc_time next_issue = sc_time_stamp();
+    sc_time end = cfg.duration == SC_ZERO_TIME ? sc_max_time() : sc_time_stamp() + cfg.duration;
+
+    // Dependent accesses allow only one request at a time
+    unsigned int limit = cfg.pattern == Traffic_config::POINTER_CHASE ? 1 : cfg.outstanding;
+
+    m_chase = m_random.next() & chase_mask();
+
+    for (sc_dt::uint64 i = 0; cfg.n_trans == 0 || i < cfg.n_trans; i++)
+    {
+      if (next_issue > sc_time_stamp())
+        wait( next_issue - sc_time_stamp() );
+      next_issue += cfg.interval;
+
+      wait_for_slot( limit );
+
+      if (sc_time_stamp() >= end)
+        break;
+
+      bool read = m_random.uniform() < cfg.read_fraction;
+      tlm::tlm_generic_payload* trans = allocate( read ? tlm::TLM_READ_COMMAND : tlm::TLM_WRITE_COMMAND,
+                                                  next_address(i), cfg.size );
+      if (!read)
+      {
+        unsigned int word = (unsigned int)i;
+        memcpy( trans->get_data_ptr(), &word, cfg.size < 4 ? cfg.size : 4 );
+      }
+
+      issue( *trans );
+    }
+  }
+
+  Traffic_config cfg;
+
+private:
+  sc_dt::uint64 next_address( sc_dt::uint64 i )
+  {
+    sc_dt::uint64 slots = cfg.span / cfg.size;
+    switch (cfg.pattern)
+    {
+    case Traffic_config::SEQUENTIAL:
+      return cfg.base + (i % slots) * cfg.size;
+
+    case Traffic_config::STRIDED:
+      {
+        sc_dt::uint64 offset = (i * cfg.stride) % (slots * cfg.size);
+        return cfg.base + offset - offset % cfg.size;
+      }
+
+    case Traffic_config::HOT_SPOT:
+      if (m_random.uniform() < cfg.hot_fraction)
+        return cfg.hot_base + pick(cfg.hot_span / cfg.size) * cfg.size;
+      return cfg.base + pick(slots) * cfg.size;
+
+    case Traffic_config::POINTER_CHASE:
+      // A full-period LCG modulo a power of two, scrambled by a bijection on the same bits
+      m_chase = (m_chase * 6364136223846793005ULL + 1442695040888963407ULL) & chase_mask();
+      return cfg.base + scramble(m_chase) * cfg.size;
+
+    case Traffic_config::RANDOM:
+    default:
+      return cfg.base + pick(slots) * cfg.size;
+    }
+  }
+
+  sc_dt::uint64 pick( sc_dt::uint64 n )
+  {
+    return n <= 0xFFFFFFFFULL ? m_random.below( (unsigned int)n ) : m_random.next() % n;
+  }
+
+  sc_dt::uint64 chase_mask() const { return (sc_dt::uint64(1) << m_chase_bits) - 1; }
+
+  sc_dt::uint64 scramble( sc_dt::uint64 x ) const
+  {
+    unsigned int shift = (m_chase_bits + 1) / 2;
+    if (shift == 0)
+      return 0;
+    x ^= x >> shift;
+    x = (x * 0x9E3779B97F4A7C15ULL) & chase_mask();
+    return x ^ (x >> shift);
+  }
+
+  sc_dt::uint64 m_chase;
+  unsigned int  m_chase_bits;
+  Random_stream m_random;
+};
+
+#endif
@@ -0,0 +1,230 @@
+
+// Filename: checker_bench.cpp
+
+//----------------------------------------------------------------------
+//  Licensed under the Apache License, Version 2.0 (the "License");
+//  you may not use this file except in compliance with the License.
+//  You may obtain a copy of the License at
+//
+//  http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+//----------------------------------------------------------------------
+
+// Version 1  16-Oct-2026
+// Version 2  16-Oct-2026  Sampled and pass-through checkers
+// Version 3  16-Oct-2026  Logging checkers
+// Version 4  16-Oct-2026  How to measure the hash table against std::map
+// Version 5  16-Oct-2026  The before and after figures are to be taken on at_example itself
+
+/*
+
+Protocol checker overhead benchmark
+
+Builds a netlist of the shape of at_example: four streaming initiators, one AT_interconnect
+and five pipelined targets, with a tlm2_base_protocol_checker on each of the nine sockets.
+The initiators and targets are not those of at_example, so the figures from here are not
+those of at_example. The initiators stream 64-byte reads spread over all five targets.
+The same system is then run without the checkers, with checkers that sample one transaction
+lifetime in 100, and with pass-through checkers (tlm2_base_protocol_checker<32, false>), and
+with logging checkers that only record each call for offline checking (see tlm2_checker_log.h).
+The difference in host time from the run without checkers is the cost of checking. The time of the logging run includes writing
+out the rest of the log after the simulation, and the log is left in checker_bench_events.bin
+for tools/checker_replay.
+
+The full run checks every transaction. Build with make STD_MAP=1 (after make clean) to measure
+the checkers with the std::map bookkeeping of version 5 of the checker, for comparison.
+
+The before and after figures for the hash table are to be taken on at_example itself, whose
+nine checkers are tlm2_base_protocol_checker<32, true>. Its Makefile takes the same STD_MAP=1
+option, and each build is timed over the same run on an otherwise idle host:
+
+  cd at_example
+  make clean && make OPT=-O2 STD_MAP=1 && time ./out    # before: std::map
+  make clean && make OPT=-O2 && time ./out              # after: hash table
+
+The wall-clock times of the two runs are still to be recorded here. They have not been
+measured yet, so the comparison asked for is outstanding.
+
+Usage: out [n_transactions per initiator]
+
+SystemC can only elaborate once per process, so each run is made in a child process.
+
+*/
+
+#include "at_interconnect.h"
+#include "stream_modules.h"
+#include "tlm2_checker_log.h"
+
+#include <chrono>
+#include <unistd.h>
+#include <sys/wait.h>
+
+
+static const unsigned int N_INIT = 4;
+static const unsigned int N_TARG = 5;
+static const unsigned int LENGTH = 64;
+
+
+template <typename checker_t>
+struct Top: sc_module
+{
+  Streaming_initiator* initiator[N_INIT];
+  AT_interconnect*     interconnect;
+  Pipelined_target*    target[N_TARG];
+
+  checker_t* check_init[N_INIT];
+  checker_t* check_targ[N_TARG];
+
+  Top( sc_module_name name, int n_trans, bool checked )
+  {
+    interconnect = new AT_interconnect("interconnect");
+
+    for (unsigned int i = 0; i < N_INIT; i++)
+    {
+      ostringstream oss;
+      oss << "initiator" << i;
+      initiator[i] = new Streaming_initiator(oss.str().c_str(), n_trans, LENGTH);
+
+      // Without a memory map the interconnect selects the target from address bits [15:8]
+      initiator[i]->set_address_range( 0, N_TARG * 0x100 );
+
+      if (checked)
+      {
+        oss.str("");
+        oss << "check_init" << i;
+        check_init[i] = new checker_t(oss.str().c_str());
+        initiator[i]->socket.bind( check_init[i]->target_socket );
+        check_init[i]->initiator_socket.bind( interconnect->targ_socket );
+      }
+      else
+        initiator[i]->socket.bind( interconnect->targ_socket );
+    }
+
+    for (unsigned int t = 0; t < N_TARG; t++)
+    {
+      ostringstream oss;
+      oss << "target" << t;
+      target[t] = new Pipelined_target(oss.str().c_str(), sc_time(1, SC_NS), sc_time(20, SC_NS), 10);
+
+      if (checked)
+      {
+        oss.str("");
+        oss << "check_targ" << t;
+        check_targ[t] = new checker_t(oss.str().c_str());
+        interconnect->init_socket.bind( check_targ[t]->target_socket );
+        check_targ[t]->initiator_socket.bind( target[t]->socket );
+      }
+      else
+        interconnect->init_socket.bind( target[t]->socket );
+    }
+  }
+};
+
+
+enum run_mode_t { NONE, ALL, SAMPLED, PASS_THROUGH, LOGGED };
+
+
+// Runs the system and returns the host time in seconds
+template <typename checker_t>
+static double run( int n_trans, bool checked )
+{
+  chrono::steady_clock::time_point t0 = chrono::steady_clock::now();
+
+  Top<checker_t> top("top", n_trans, checked);
+  sc_start();
+
+  chrono::steady_clock::time_point t1 = chrono::steady_clock::now();
+
+  for (unsigned int i = 0; i < N_INIT; i++)
+    if (top.initiator[i]->n_done != n_trans)
+      SC_REPORT_ERROR("checker_bench", "Not all transactions completed");
+
+  return chrono::duration<double>(t1 - t0).count();
+}
+
+
+// Runs the system in a child process, which passes back the host time through a pipe
+static double run_in_child( int n_trans, run_mode_t mode )
+{
+  int fd[2];
+  if (pipe(fd) != 0)
+    SC_REPORT_FATAL("checker_bench", "Cannot create pipe");
+
+  cout.flush();
+  pid_t pid = fork();
+  if (pid == 0)
+  {
+    close(fd[0]);
+    double host_s;
+    if (mode == PASS_THROUGH)
+      host_s = run< tlm_utils::tlm2_base_protocol_checker<32, false> >( n_trans, true );
+    else if (mode == LOGGED)
+    {
+      tlm_utils::tlm2_event_log::instance().open("checker_bench_events.bin");
+      host_s = run< tlm_utils::tlm2_logging_checker<32> >( n_trans, true );
+
+      chrono::steady_clock::time_point t0 = chrono::steady_clock::now();
+      tlm_utils::tlm2_event_log::instance().close();
+      host_s += chrono::duration<double>(chrono::steady_clock::now() - t0).count();
+    }
+    else
+    {
+      if (mode == SAMPLED)
+        tlm_utils::tlm2_base_protocol_checker<>::set_sample_period(100);
+      host_s = run< tlm_utils::tlm2_base_protocol_checker<> >( n_trans, mode != NONE );
+    }
+    if (write( fd[1], &host_s, sizeof(host_s) ) != sizeof(host_s))
+      _exit(1);
+    cout.flush();
+    _exit(0);
+  }
+
+  close(fd[1]);
+  double host_s = 0.0;
+  if (read( fd[0], &host_s, sizeof(host_s) ) != sizeof(host_s))
+    SC_REPORT_ERROR("checker_bench", "Child process failed");
+  close(fd[0]);
+
+  int status;
+  waitpid( pid, &status, 0 );
+  return host_s;
+}
+
+
+int sc_main(int argc, char* argv[])
+{
+  int n_trans = argc > 1 ? atoi(argv[1]) : 250000;
+
+#ifdef TLM2_CHECKER_STD_MAP
+  cout << "Checker state in std::map" << endl;
+#else
+  cout << "Checker state in hash table" << endl;
+#endif
+
+  double total = double(n_trans) * N_INIT;
+
+  cout << setw(12) << "checkers" << setw(12) << "host s"
+       << setw(16) << "trans/s host" << setw(14) << "ns/trans" << endl;
+
+  const char* label[] = { "none", "all", "1 in 100", "pass", "log" };
+  double      host_s[5];
+  for (unsigned int m = NONE; m <= LOGGED; m++)
+    host_s[m] = run_in_child( n_trans, run_mode_t(m) );
+
+  for (unsigned int m = NONE; m <= LOGGED; m++)
+  {
+    cout << setw(12) << label[m]
+         << setw(12) << setprecision(3) << fixed << host_s[m]
+         << setw(16) << setprecision(0) << (host_s[m] > 0 ? total / host_s[m] : 0.0)
+         << setw(14) << setprecision(1) << 1e9 * host_s[m] / total;
+    if (m != NONE && host_s[NONE] > 0)
+      cout << "   overhead " << 100.0 * (host_s[m] - host_s[NONE]) / host_s[NONE] << "%";
+    cout << endl;
+  }
+  return 0;
+}
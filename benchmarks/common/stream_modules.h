@@ -0,0 +1,275 @@
+
+// Filename: stream_modules.h
+
+//----------------------------------------------------------------------
+//  Licensed under the Apache License, Version 2.0 (the "License");
+//  you may not use this file except in compliance with the License.
+//  You may obtain a copy of the License at
+//
+//  http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+//----------------------------------------------------------------------
+
+// Version 1  16-Oct-2026
+// Version 2  16-Oct-2026  Reads may be spread over an address range
+// Version 3  16-Oct-2026  Data storage owned by each payload
+// Version 4  16-Oct-2026  Random numbers from a stream per module
+// Version 5  16-Oct-2026  Release a payload completed on the forward path
+
+
+// *******************************************************************
+// Streaming initiator and pipelined target shared by the benchmarks
+// *******************************************************************
+
+#ifndef __STREAM_MODULES_H__
+#define __STREAM_MODULES_H__
+
+#include "common_header.h"
+
+#include <vector>
+#include <map>
+#include <cstring>
+
+struct Streaming_initiator: sc_module
+{
+  // Issues reads of the given length back to back, honouring only the BEGIN_REQ/END_REQ
+  // exclusion rule. Counts the responses that arrive out of issue order
+
+  tlm_utils::simple_initiator_socket<Streaming_initiator, 32> socket;
+
+  SC_HAS_PROCESS(Streaming_initiator);
+
+  Streaming_initiator( sc_module_name name, int n, unsigned int len )
+  : socket("socket")
+  , length(len)
+  , n_trans(n)
+  , addr_base(0)
+  , addr_span(0)
+  , n_done(0)
+  , n_out_of_order(0)
+  , next_seq(0)
+  , last_seq(-1)
+  , req_in_progress(0)
+  , m_peq(this, &Streaming_initiator::peq_cb)
+  , m_random(this->name())
+  {
+    socket.register_nb_transport_bw(this, &Streaming_initiator::nb_transport_bw);
+
+    SC_THREAD(thread_process);
+  }
+
+  // Spread the reads at random over [base, base + span), aligned to their length, rather than
+  // cycling through the first 256 bytes
+  void set_address_range( sc_dt::uint64 base, sc_dt::uint64 span )
+  {
+    addr_base = base;
+    addr_span = span;
+  }
+
+  void thread_process()
+  {
+    for (int i = 0; i < n_trans; i++)
+    {
+      tlm::tlm_generic_payload* trans = m_mm.allocate();
+      trans->acquire();
+
+      trans->set_command( tlm::TLM_READ_COMMAND );
+      if (addr_span >= length)
+        trans->set_address( addr_base + sc_dt::uint64( m_random.below( (unsigned int)(addr_span / length) ) ) * length );
+      else
+        trans->set_address( (i * 4) & 0xfc );
+      trans->set_data_ptr( m_mm.data(trans, length) );
+      trans->set_data_length( length );
+      trans->set_streaming_width( length );
+      trans->set_byte_enable_ptr( 0 );
+      trans->set_dmi_allowed( false );
+      trans->set_response_status( tlm::TLM_INCOMPLETE_RESPONSE );
+
+      seq[trans] = next_seq++;
+
+      if (req_in_progress)
+        wait(end_req_event);
+      req_in_progress = trans;
+
+      tlm::tlm_phase phase = tlm::BEGIN_REQ;
+      sc_time delay = SC_ZERO_TIME;
+
+      tlm::tlm_sync_enum status = socket->nb_transport_fw( *trans, phase, delay );
+
+      if (status == tlm::TLM_UPDATED)
+        m_peq.notify( *trans, phase, delay );
+      else if (status == tlm::TLM_COMPLETED)
+      {
+        req_in_progress = 0;
+        response( *trans );
+        trans->release();
+      }
+    }
+  }
+
+  virtual tlm::tlm_sync_enum nb_transport_bw( tlm::tlm_generic_payload& trans,
+                                              tlm::tlm_phase& phase, sc_time& delay )
+  {
+    m_peq.notify( trans, phase, delay );
+    return tlm::TLM_ACCEPTED;
+  }
+
+  void peq_cb( tlm::tlm_generic_payload& trans, const tlm::tlm_phase& phase )
+  {
+    end_request( trans );
+
+    if (phase == tlm::BEGIN_RESP)
+    {
+      response( trans );
+
+      tlm::tlm_phase fw_phase = tlm::END_RESP;
+      sc_time delay = SC_ZERO_TIME;
+      socket->nb_transport_fw( trans, fw_phase, delay );
+      trans.release();
+    }
+  }
+
+  void end_request( tlm::tlm_generic_payload& trans )
+  {
+    if (&trans == req_in_progress)
+    {
+      req_in_progress = 0;
+      end_req_event.notify();
+    }
+  }
+
+  void response( tlm::tlm_generic_payload& trans )
+  {
+    int s = seq[&trans];
+    seq.erase(&trans);
+    if (s < last_seq)
+      n_out_of_order++;
+    else
+      last_seq = s;
+
+    n_done++;
+    last_rsp = sc_time_stamp();
+  }
+
+  mm  m_mm;
+  unsigned int length;
+  int n_trans;
+  sc_dt::uint64 addr_base;
+  sc_dt::uint64 addr_span;
+  int n_done;
+  int n_out_of_order;
+  int next_seq;
+  int last_seq;
+  sc_time last_rsp;
+  std::map<tlm::tlm_generic_payload*, int> seq;
+  tlm::tlm_generic_payload* req_in_progress;
+  sc_event end_req_event;
+  tlm_utils::peq_with_cb_and_phase<Streaming_initiator> m_peq;
+  Random_stream m_random;
+};
+
+
+struct Pipelined_target: sc_module
+{
+  // Accepts any number of requests, one per accept delay, and sends one response at a time
+  // after the latency plus a random jitter of up to jitter_ns nanoseconds
+
+  tlm_utils::simple_target_socket<Pipelined_target, 32> socket;
+
+  SC_HAS_PROCESS(Pipelined_target);
+
+  Pipelined_target( sc_module_name name, const sc_time& accept_delay,
+                    const sc_time& latency_delay, int jitter )
+  : socket("socket")
+  , accept(accept_delay)
+  , latency(latency_delay)
+  , jitter_ns(jitter)
+  , response_in_progress(false)
+  , m_peq(this, &Pipelined_target::peq_cb)
+  , m_random(this->name())
+  {
+    socket.register_nb_transport_fw(this, &Pipelined_target::nb_transport_fw);
+  }
+
+  virtual tlm::tlm_sync_enum nb_transport_fw( tlm::tlm_generic_payload& trans,
+                                              tlm::tlm_phase& phase, sc_time& delay )
+  {
+    m_peq.notify( trans, phase, delay );
+    return tlm::TLM_ACCEPTED;
+  }
+
+  void peq_cb( tlm::tlm_generic_payload& trans, const tlm::tlm_phase& phase )
+  {
+    if (phase == tlm::BEGIN_REQ)
+    {
+      trans.acquire();
+      memset( trans.get_data_ptr(), 0, trans.get_data_length() );
+      trans.set_response_status( tlm::TLM_OK_RESPONSE );
+
+      tlm::tlm_phase bw_phase = tlm::END_REQ;
+      sc_time delay = accept;
+      socket->nb_transport_bw( trans, bw_phase, delay );
+
+      delay = latency + sc_time(jitter_ns ? m_random.below(jitter_ns) : 0, SC_NS);
+      m_peq.notify( trans, internal_ph, delay );
+    }
+    else if (phase == internal_ph)
+    {
+      rsp_queue.push_back( &trans );
+      if (!response_in_progress)
+        send_response();
+    }
+    else if (phase == tlm::END_RESP)
+    {
+      finished();
+    }
+  }
+
+  void send_response()
+  {
+    tlm::tlm_generic_payload* trans = rsp_queue.front();
+    rsp_queue.pop_front();
+    response_in_progress = true;
+
+    tlm::tlm_phase bw_phase = tlm::BEGIN_RESP;
+    sc_time delay = SC_ZERO_TIME;
+    tlm::tlm_sync_enum status = socket->nb_transport_bw( *trans, bw_phase, delay );
+
+    if (status == tlm::TLM_COMPLETED)
+    {
+      trans->release();
+      finished_no_release();
+    }
+    else
+      in_flight = trans;
+  }
+
+  void finished()
+  {
+    in_flight->release();
+    finished_no_release();
+  }
+
+  void finished_no_release()
+  {
+    response_in_progress = false;
+    if (!rsp_queue.empty())
+      send_response();
+  }
+
+  sc_time accept;
+  sc_time latency;
+  int     jitter_ns;
+  bool    response_in_progress;
+  tlm::tlm_generic_payload* in_flight;
+  std::deque<tlm::tlm_generic_payload*> rsp_queue;
+  tlm_utils::peq_with_cb_and_phase<Pipelined_target> m_peq;
+  Random_stream m_random;
+};
+
+#endif
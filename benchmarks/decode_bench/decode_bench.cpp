@@ -0,0 +1,116 @@
+
+// Filename: decode_bench.cpp
+
+//----------------------------------------------------------------------
+//  Licensed under the Apache License, Version 2.0 (the "License");
+//  you may not use this file except in compliance with the License.
+//  You may obtain a copy of the License at
+//
+//  http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+//----------------------------------------------------------------------
+
+// Version 1  16-Oct-2026
+
+/*
+
+Address decode benchmark
+
+Measures the host cost of Memory_map::decode, as used by AT_interconnect, as the number of
+regions in the memory map grows. Regions have random sizes and are scattered over the full
+64-bit address space. Each row reports the mean cost of one decode over a fixed stream of
+addresses that all hit a mapped region, next to the cost of the fixed shift-and-mask decode
+that AT_interconnect uses when no memory map is given.
+
+Usage: out [n_decodes]
+
+*/
+
+#include "memory_map.h"
+
+#include <iostream>
+#include <iomanip>
+#include <random>
+#include <chrono>
+
+using namespace std;
+
+static const unsigned int N_TARGETS = 32;
+
+double ns_per_decode( const Memory_map& map, const vector<sc_dt::uint64>& addresses,
+                      unsigned int& checksum )
+{
+  chrono::steady_clock::time_point t0 = chrono::steady_clock::now();
+
+  for (size_t i = 0; i < addresses.size(); i++)
+  {
+    const Memory_region* r = map.decode( addresses[i] );
+    checksum += r ? r->target + unsigned(r->to_local(addresses[i])) : 0;
+  }
+
+  chrono::steady_clock::time_point t1 = chrono::steady_clock::now();
+  return chrono::duration<double, nano>(t1 - t0).count() / addresses.size();
+}
+
+double ns_per_legacy_decode( const vector<sc_dt::uint64>& addresses, unsigned int& checksum )
+{
+  chrono::steady_clock::time_point t0 = chrono::steady_clock::now();
+
+  for (size_t i = 0; i < addresses.size(); i++)
+  {
+    sc_dt::uint64 masked_address = addresses[i] & 0xff;
+    unsigned int  target = (unsigned int)(addresses[i] >> 8) % N_TARGETS;
+    checksum += target + unsigned(masked_address);
+  }
+
+  chrono::steady_clock::time_point t1 = chrono::steady_clock::now();
+  return chrono::duration<double, nano>(t1 - t0).count() / addresses.size();
+}
+
+
+int sc_main(int argc, char* argv[])
+{
+  size_t n_decodes = argc > 1 ? strtoul(argv[1], 0, 0) : 4000000;
+
+  mt19937_64 rng(1);
+  unsigned int checksum = 0;
+
+  cout << setw(10) << "regions" << setw(16) << "ns/decode" << endl;
+
+  for (unsigned int n_regions = 1; n_regions <= (1u << 20); n_regions *= 4)
+  {
+    Memory_map map;
+
+    // Carve the address space into equal slots and place one region of random size in each
+    sc_dt::uint64 slot = n_regions == 1 ? ~sc_dt::uint64(0) / 2 : (~sc_dt::uint64(0) / n_regions);
+    vector<Memory_region> regions;
+    for (unsigned int i = 0; i < n_regions; i++)
+    {
+      sc_dt::uint64 size = 1 + rng() % (slot / 2);
+      sc_dt::uint64 base = i * slot + rng() % (slot - size);
+      map.add_region( base, size, i % N_TARGETS, rng() % 0x100000 );
+    }
+    map.build( N_TARGETS );
+
+    vector<sc_dt::uint64> addresses(n_decodes);
+    for (size_t i = 0; i < addresses.size(); i++)
+    {
+      const Memory_region& r = map.region( rng() % n_regions );
+      addresses[i] = r.base + rng() % r.size;
+    }
+
+    cout << setw(10) << n_regions << setw(16) << fixed << setprecision(2)
+         << ns_per_decode( map, addresses, checksum ) << endl;
+
+    if (n_regions == 1)
+      cout << setw(10) << "fixed" << setw(16) << ns_per_legacy_decode( addresses, checksum ) << endl;
+  }
+
+  cout << "(checksum " << checksum << ")" << endl;
+  return 0;
+}
@@ -0,0 +1,98 @@
+
+// Filename: link_bench.cpp
+
+//----------------------------------------------------------------------
+//  Licensed under the Apache License, Version 2.0 (the "License");
+//  you may not use this file except in compliance with the License.
+//  You may obtain a copy of the License at
+//
+//  http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+//----------------------------------------------------------------------
+
+// Version 1  16-Oct-2026
+
+/*
+
+Link bandwidth benchmark
+
+Sweeps the bus width of the AT_interconnect link model to find the knee of the throughput
+curve. Each row is an independent system of one streaming initiator issuing reads of a fixed
+length, one interconnect with a 1 GHz link, and one pipelined target, all run side by side
+in one simulation. The last row uses the fixed 1000 ps response delay of the interconnect
+with no link model.
+
+Usage: out [n_transactions] [length]
+
+*/
+
+#include "at_interconnect.h"
+#include "stream_modules.h"
+
+
+struct System: sc_module
+{
+  Streaming_initiator* initiator;
+  AT_interconnect*     interconnect;
+  Pipelined_target*    target;
+
+  unsigned int width;
+
+  System( sc_module_name name, int n_trans, unsigned int length, unsigned int bus_width )
+  : width(bus_width)
+  {
+    initiator    = new Streaming_initiator("initiator", n_trans, length);
+    interconnect = new AT_interconnect("interconnect");
+    target       = new Pipelined_target("target", sc_time(1, SC_NS), sc_time(20, SC_NS), 0);
+
+    if (width)
+      interconnect->set_link( width, sc_time(1, SC_NS) );
+
+    initiator->socket.bind( interconnect->targ_socket );
+    interconnect->init_socket.bind( target->socket );
+  }
+};
+
+
+int sc_main(int argc, char* argv[])
+{
+  int          n_trans = argc > 1 ? atoi(argv[1]) : 10000;
+  unsigned int length  = argc > 2 ? atoi(argv[2]) : 64;
+
+  // A width of 0 leaves the link model disabled
+  unsigned int widths[] = { 1, 2, 4, 8, 16, 32, 64, 128, 256, 0 };
+  const unsigned int n_widths = sizeof(widths) / sizeof(widths[0]);
+
+  std::vector<System*> systems;
+  for (unsigned int i = 0; i < n_widths; i++)
+  {
+    ostringstream oss;
+    oss << "sys_" << widths[i];
+    systems.push_back( new System( oss.str().c_str(), n_trans, length, widths[i] ) );
+  }
+
+  sc_start();
+
+  cout << setw(10) << "bus width" << setw(14) << "bytes/ns" << setw(20) << "rsp link busy %" << endl;
+
+  for (unsigned int i = 0; i < systems.size(); i++)
+  {
+    System* s = systems[i];
+    if (s->initiator->n_done != n_trans)
+      SC_REPORT_ERROR("link_bench", "Not all transactions completed");
+
+    double ns = s->initiator->last_rsp.to_seconds() * 1e9;
+    cout << setw(10) << (s->width ? to_string(s->width) : string("fixed"))
+         << setw(14) << fixed << setprecision(3) << (ns > 0 ? double(n_trans) * length / ns : 0.0)
+         << setw(20) << setprecision(1)
+         << 100.0 * s->interconnect->get_response_link(0).busy_total.to_seconds()
+                  / s->initiator->last_rsp.to_seconds()
+         << endl;
+  }
+  return 0;
+}
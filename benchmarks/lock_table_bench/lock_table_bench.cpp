@@ -0,0 +1,163 @@
+
+// Filename: lock_table_bench.cpp
+
+//----------------------------------------------------------------------
+//  Licensed under the Apache License, Version 2.0 (the "License");
+//  you may not use this file except in compliance with the License.
+//  You may obtain a copy of the License at
+//
+//  http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+//----------------------------------------------------------------------
+
+// Version 1  16-Oct-2026
+
+/*
+
+Lock table benchmark
+
+Measures the host cost of the lock check that Lock_interconnect makes on every transaction,
+with the Lock_table of locking_and_snooping/common against the pair of std::maps it
+replaced, whose operator[] added a node for every address ever accessed. Each address of
+the stream is distinct, as for a workload sweeping a large memory.
+
+  plain        ordinary accesses while no lock is held
+  plain+locks  ordinary accesses while n_locks addresses stay locked
+  lock/unlock  each address locked then unlocked by the same initiator
+
+The entries column is the number of entries left in the structure after the run.
+
+Usage: out [n_addresses] [n_locks]
+
+*/
+
+#include "lock_table.h"
+
+#include <iostream>
+#include <iomanip>
+#include <random>
+#include <chrono>
+#include <map>
+#include <algorithm>
+
+using namespace std;
+
+
+// The lookups of Lock_interconnect before the Lock_table
+struct Map_locks
+{
+  bool locked( sc_dt::uint64 adr ) { return lock_map[adr]; }
+
+  void lock( sc_dt::uint64 adr, int id )
+  {
+    lock_map[adr] = true;
+    lock_id[adr] = id;
+  }
+
+  void unlock( sc_dt::uint64 adr, int id )
+  {
+    if ( lock_map[adr] )
+      if ( lock_id[adr] == 0 || lock_id[adr] == id )
+        lock_map[adr] = false;
+  }
+
+  size_t entries() const { return lock_map.size() + lock_id.size(); }
+
+  std::map <sc_dt::uint64, bool> lock_map;
+  std::map <sc_dt::uint64, int>  lock_id;
+};
+
+struct Table_locks
+{
+  bool locked( sc_dt::uint64 adr ) { return table.locked(adr); }
+
+  void lock( sc_dt::uint64 adr, int id ) { table.lock(adr, id); }
+
+  void unlock( sc_dt::uint64 adr, int id )
+  {
+    const int* owner = table.owner(adr);
+    if ( owner && (*owner == 0 || *owner == id) )
+      table.unlock(adr);
+  }
+
+  size_t entries() const { return table.size(); }
+
+  Lock_table table;
+};
+
+
+enum test_t { PLAIN, PLAIN_LOCKS, LOCK_UNLOCK };
+
+template <typename Locks>
+double ns_per_access( test_t test, const vector<sc_dt::uint64>& addresses,
+                      const vector<sc_dt::uint64>& held, size_t& entries, unsigned int& checksum )
+{
+  Locks locks;
+  if (test == PLAIN_LOCKS)
+    for (size_t i = 0; i < held.size(); i++)
+      locks.lock( held[i], 1 );
+
+  chrono::steady_clock::time_point t0 = chrono::steady_clock::now();
+
+  for (size_t i = 0; i < addresses.size(); i++)
+  {
+    if (test == LOCK_UNLOCK)
+    {
+      checksum += locks.locked( addresses[i] );
+      locks.lock( addresses[i], 2 );
+      locks.unlock( addresses[i], 2 );
+    }
+    else
+      checksum += locks.locked( addresses[i] );
+  }
+
+  chrono::steady_clock::time_point t1 = chrono::steady_clock::now();
+  entries = locks.entries();
+  return chrono::duration<double, nano>(t1 - t0).count() / addresses.size();
+}
+
+
+int sc_main(int argc, char* argv[])
+{
+  size_t n_addresses = argc > 1 ? strtoul(argv[1], 0, 0) : 4000000;
+  size_t n_locks     = argc > 2 ? strtoul(argv[2], 0, 0) : 16;
+
+  mt19937_64 rng(1);
+  unsigned int checksum = 0;
+
+  // Distinct word addresses in a random order, over a 64 GB memory
+  vector<sc_dt::uint64> addresses(n_addresses);
+  for (size_t i = 0; i < n_addresses; i++)
+    addresses[i] = (sc_dt::uint64)i * 4;
+  shuffle( addresses.begin(), addresses.end(), rng );
+  for (size_t i = 0; i < n_addresses; i++)
+    addresses[i] = (addresses[i] * 4099) & ((sc_dt::uint64(1) << 36) - 1);
+
+  // Locked addresses outside the stream
+  vector<sc_dt::uint64> held(n_locks);
+  for (size_t i = 0; i < n_locks; i++)
+    held[i] = (sc_dt::uint64(1) << 36) + i * 64;
+
+  const char* names[] = { "plain", "plain+locks", "lock/unlock" };
+
+  cout << setw(14) << "test" << setw(14) << "map ns" << setw(14) << "table ns"
+       << setw(14) << "map entries" << setw(16) << "table entries" << endl;
+
+  for (int t = PLAIN; t <= LOCK_UNLOCK; t++)
+  {
+    size_t map_entries, table_entries;
+    double map_ns   = ns_per_access<Map_locks>  ( test_t(t), addresses, held, map_entries, checksum );
+    double table_ns = ns_per_access<Table_locks>( test_t(t), addresses, held, table_entries, checksum );
+
+    cout << setw(14) << names[t] << setw(14) << fixed << setprecision(2) << map_ns
+         << setw(14) << table_ns << setw(14) << map_entries << setw(16) << table_entries << endl;
+  }
+
+  cout << "(checksum " << checksum << ")" << endl;
+  return 0;
+}
@@ -0,0 +1,240 @@
+
+// Filename: mm_bench.cpp
+
+//----------------------------------------------------------------------
+//  Licensed under the Apache License, Version 2.0 (the "License");
+//  you may not use this file except in compliance with the License.
+//  You may obtain a copy of the License at
+//
+//  http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+//----------------------------------------------------------------------
+
+// Version 1  16-Oct-2026
+
+/*
+
+Memory manager benchmark
+
+Compares three ways of obtaining generic payloads: the slab-allocated mm of at_example,
+the original mm (a free list of separately allocated access nodes over payloads allocated
+one at a time), and plain new/delete.
+
+Two access patterns are measured:
+
+  single   Allocate one payload, fill in its attributes and free it, repeatedly
+  batch    Allocate a batch of payloads, fill them in, then free them all in allocation
+           order, as when many transactions are in flight at once
+
+Each row gives the mean host time of one allocate/free pair and, where the kernel allows
+access to the hardware counters, the number of cache misses per pair.
+
+Usage: out [n_pairs] [batch_size]
+
+*/
+
+#include "mm.h"
+
+#include <iostream>
+#include <iomanip>
+#include <vector>
+#include <chrono>
+#include <cstring>
+
+#include <unistd.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <linux/perf_event.h>
+
+using namespace std;
+
+typedef tlm::tlm_generic_payload gp_t;
+
+
+// The memory manager of at_example before the slab pool
+class legacy_mm: public tlm::tlm_mm_interface
+{
+public:
+  legacy_mm() : free_list(0), empties(0) {}
+
+  gp_t* allocate()
+  {
+    gp_t* ptr;
+    if (free_list)
+    {
+      ptr = free_list->trans;
+      empties = free_list;
+      free_list = free_list->next;
+    }
+    else
+    {
+      ptr = new gp_t(this);
+    }
+    return ptr;
+  }
+
+  void free(gp_t* trans)
+  {
+    trans->reset();
+    if (!empties)
+    {
+      empties = new access;
+      empties->next = free_list;
+      empties->prev = 0;
+      if (free_list)
+        free_list->prev = empties;
+    }
+    free_list = empties;
+    free_list->trans = trans;
+    empties = free_list->prev;
+  }
+
+private:
+  struct access
+  {
+    gp_t* trans;
+    access* next;
+    access* prev;
+  };
+
+  access* free_list;
+  access* empties;
+};
+
+
+struct new_delete_mm
+{
+  gp_t* allocate()          { return new gp_t; }
+  void  free( gp_t* trans ) { delete trans; }
+};
+
+
+// Hardware cache miss counter for this thread, if available
+class Cache_misses
+{
+public:
+  Cache_misses() : fd(-1)
+  {
+    perf_event_attr attr;
+    memset( &attr, 0, sizeof(attr) );
+    attr.type           = PERF_TYPE_HARDWARE;
+    attr.size           = sizeof(attr);
+    attr.config         = PERF_COUNT_HW_CACHE_MISSES;
+    attr.disabled       = 1;
+    attr.exclude_kernel = 1;
+    attr.exclude_hv     = 1;
+    fd = syscall( __NR_perf_event_open, &attr, 0, -1, -1, 0 );
+  }
+
+  ~Cache_misses() { if (fd >= 0) close(fd); }
+
+  bool available() const { return fd >= 0; }
+
+  void start()
+  {
+    if (fd < 0) return;
+    ioctl( fd, PERF_EVENT_IOC_RESET, 0 );
+    ioctl( fd, PERF_EVENT_IOC_ENABLE, 0 );
+  }
+
+  long long stop()
+  {
+    if (fd < 0) return 0;
+    ioctl( fd, PERF_EVENT_IOC_DISABLE, 0 );
+    long long count = 0;
+    if (read( fd, &count, sizeof(count) ) != sizeof(count))
+      return 0;
+    return count;
+  }
+
+private:
+  int fd;
+};
+
+
+static void fill( gp_t* trans, size_t i, unsigned char* data )
+{
+  trans->set_command( tlm::TLM_READ_COMMAND );
+  trans->set_address( i * 4 );
+  trans->set_data_ptr( data );
+  trans->set_data_length( 4 );
+  trans->set_streaming_width( 4 );
+  trans->set_response_status( tlm::TLM_INCOMPLETE_RESPONSE );
+}
+
+template <typename MM>
+void run( const char* name, MM& pool, size_t n_pairs, size_t batch, Cache_misses& counter )
+{
+  unsigned char data[4];
+  vector<gp_t*> live(batch);
+
+  // Warm up, so that the pools are already populated
+  for (size_t i = 0; i < batch; i++)
+    live[i] = pool.allocate();
+  for (size_t i = 0; i < batch; i++)
+    pool.free( live[i] );
+
+  chrono::steady_clock::time_point t0 = chrono::steady_clock::now();
+  counter.start();
+  for (size_t i = 0; i < n_pairs; i++)
+  {
+    gp_t* trans = pool.allocate();
+    fill( trans, i, data );
+    pool.free( trans );
+  }
+  long long single_misses = counter.stop();
+  chrono::steady_clock::time_point t1 = chrono::steady_clock::now();
+
+  size_t n_batches = n_pairs / batch;
+  counter.start();
+  for (size_t b = 0; b < n_batches; b++)
+  {
+    for (size_t i = 0; i < batch; i++)
+    {
+      live[i] = pool.allocate();
+      fill( live[i], i, data );
+    }
+    for (size_t i = 0; i < batch; i++)
+      pool.free( live[i] );
+  }
+  long long batch_misses = counter.stop();
+  chrono::steady_clock::time_point t2 = chrono::steady_clock::now();
+
+  double n_batch_pairs = double(n_batches * batch);
+
+  cout << setw(12) << name << fixed << setprecision(2)
+       << setw(12) << chrono::duration<double, nano>(t1 - t0).count() / n_pairs
+       << setw(12) << chrono::duration<double, nano>(t2 - t1).count() / n_batch_pairs;
+  if (counter.available())
+    cout << setw(14) << double(single_misses) / n_pairs
+         << setw(14) << double(batch_misses) / n_batch_pairs;
+  else
+    cout << setw(14) << "n/a" << setw(14) << "n/a";
+  cout << endl;
+}
+
+
+int sc_main(int argc, char* argv[])
+{
+  size_t n_pairs = argc > 1 ? strtoul(argv[1], 0, 0) : 4000000;
+  size_t batch   = argc > 2 ? strtoul(argv[2], 0, 0) : 4096;
+
+  Cache_misses counter;
+
+  cout << setw(12) << "pool" << setw(12) << "single ns" << setw(12) << "batch ns"
+       << setw(14) << "single miss" << setw(14) << "batch miss" << endl;
+
+  mm            slab;
+  legacy_mm     legacy;
+  new_delete_mm heap;
+
+  run( "slab", slab, n_pairs, batch, counter );
+  run( "legacy", legacy, n_pairs, batch, counter );
+  run( "new/delete", heap, n_pairs, batch, counter );
+  return 0;
+}
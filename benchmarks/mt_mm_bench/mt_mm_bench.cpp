@@ -0,0 +1,148 @@
+
+// Filename: mt_mm_bench.cpp
+
+//----------------------------------------------------------------------
+//  Licensed under the Apache License, Version 2.0 (the "License");
+//  you may not use this file except in compliance with the License.
+//  You may obtain a copy of the License at
+//
+//  http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+//----------------------------------------------------------------------
+
+// Version 1  16-Oct-2026
+
+/*
+
+Thread-safe memory manager stress benchmark
+
+Runs 1 to 64 producer threads against one pool. Each thread repeatedly allocates a payload,
+fills it in and swaps it into a randomly chosen slot of a shared mailbox, freeing the payload
+it takes out, so that most payloads are freed by a different thread from the one that
+allocated them. At the end the mailbox is drained and every payload is checked to be back
+in the pool.
+
+Compares mt_mm against the single-threaded mm guarded by one mutex. Each row gives the
+total allocate/free pairs per microsecond of host time.
+
+Usage: out [pairs per thread]
+
+*/
+
+#include "mm.h"
+#include "mt_mm.h"
+
+#include <iostream>
+#include <iomanip>
+#include <vector>
+#include <thread>
+#include <mutex>
+#include <atomic>
+#include <chrono>
+
+using namespace std;
+
+typedef tlm::tlm_generic_payload gp_t;
+
+static const unsigned int MAILBOX_SIZE = 1024;
+
+
+struct locked_mm
+{
+  gp_t* allocate()
+  {
+    lock_guard<mutex> lock(m);
+    return pool.allocate();
+  }
+
+  void free( gp_t* trans )
+  {
+    lock_guard<mutex> lock(m);
+    pool.free(trans);
+  }
+
+  mutex m;
+  mm    pool;
+};
+
+
+template <typename MM>
+double pairs_per_us( MM& pool, unsigned int n_threads, size_t n_pairs )
+{
+  vector< atomic<gp_t*> > mailbox(MAILBOX_SIZE);
+  for (unsigned int i = 0; i < MAILBOX_SIZE; i++)
+    mailbox[i].store(0);
+
+  chrono::steady_clock::time_point t0 = chrono::steady_clock::now();
+
+  vector<thread> threads;
+  for (unsigned int t = 0; t < n_threads; t++)
+    threads.push_back( thread( [&pool, &mailbox, t, n_pairs]()
+    {
+      unsigned int r = t * 2654435761u + 1;
+      for (size_t i = 0; i < n_pairs; i++)
+      {
+        gp_t* trans = pool.allocate();
+        trans->set_address( i );
+        trans->set_command( tlm::TLM_WRITE_COMMAND );
+
+        r = r * 1103515245u + 12345u;
+        gp_t* old = mailbox[ (r >> 8) % MAILBOX_SIZE ].exchange( trans );
+        if (old)
+          pool.free( old );
+      }
+    } ) );
+
+  for (unsigned int t = 0; t < n_threads; t++)
+    threads[t].join();
+
+  chrono::steady_clock::time_point t1 = chrono::steady_clock::now();
+
+  for (unsigned int i = 0; i < MAILBOX_SIZE; i++)
+  {
+    gp_t* trans = mailbox[i].exchange(0);
+    if (trans)
+      pool.free( trans );
+  }
+
+  return double(n_threads) * n_pairs / chrono::duration<double, micro>(t1 - t0).count();
+}
+
+
+int sc_main(int argc, char* argv[])
+{
+  size_t n_pairs = argc > 1 ? strtoul(argv[1], 0, 0) : 1000000;
+
+  unsigned int counts[] = { 1, 2, 4, 8, 16, 32, 64 };
+
+  cout << setw(10) << "threads" << setw(14) << "mt_mm" << setw(14) << "locked mm"
+       << setw(12) << "payloads" << endl;
+
+  for (unsigned int i = 0; i < sizeof(counts) / sizeof(counts[0]); i++)
+  {
+    mt_mm     lock_free;
+    locked_mm locked;
+
+    double a = pairs_per_us( lock_free, counts[i], n_pairs );
+    double b = pairs_per_us( locked,    counts[i], n_pairs );
+
+    // Every payload must be back in the pool: allocating them all again must not grow it
+    unsigned int size = lock_free.size();
+    vector<gp_t*> all;
+    for (unsigned int j = 0; j < size; j++)
+      all.push_back( lock_free.allocate() );
+    if (lock_free.size() != size)
+      SC_REPORT_ERROR("mt_mm_bench", "Payloads lost from the pool");
+    for (unsigned int j = 0; j < size; j++)
+      lock_free.free( all[j] );
+
+    cout << setw(10) << counts[i] << fixed << setprecision(2)
+         << setw(14) << a << setw(14) << b << setw(12) << size << endl;
+  }
+  return 0;
+}
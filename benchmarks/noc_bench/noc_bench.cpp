@@ -0,0 +1,151 @@
+
+// Filename: noc_bench.cpp
+
+//----------------------------------------------------------------------
+//  Licensed under the Apache License, Version 2.0 (the "License");
+//  you may not use this file except in compliance with the License.
+//  You may obtain a copy of the License at
+//
+//  http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+//----------------------------------------------------------------------
+
+// Version 1  16-Oct-2026
+
+/*
+
+Network on chip benchmark
+
+Builds a k x k network of Noc_router instances (see noc.h) with one streaming initiator
+and one pipelined target at every node. Each initiator issues 64-byte reads to addresses
+spread uniformly over the whole network. Links are 16 bytes wide at 1 GHz and every router
+adds 2 ns per hop.
+
+Reports the mean number of links crossed, the simulated throughput, the peak utilization
+of any link between two routers, and the host time taken to elaborate and simulate.
+
+Usage: out [mesh|ring] [k] [n_transactions per initiator]
+
+With no k, or k = 0, sweeps k = 2, 4, 8 and 16. SystemC can only elaborate once per process,
+so each size of the sweep runs in a child process of its own.
+
+*/
+
+#include "noc.h"
+#include "stream_modules.h"
+
+#include <chrono>
+#include <unistd.h>
+#include <sys/wait.h>
+
+
+static const sc_dt::uint64 NODE_SIZE = 0x10000;
+static const unsigned int  LENGTH    = 64;
+
+
+struct Top: sc_module
+{
+  Noc_fabric* fabric;
+  std::vector<Streaming_initiator*> initiator;
+  std::vector<Pipelined_target*>    target;
+
+  Top( sc_module_name name, Noc_fabric::topology_t topology, unsigned int k, int n_trans )
+  {
+    fabric = new Noc_fabric("fabric", topology, k, k, NODE_SIZE);
+    fabric->set_hop_latency( sc_time(2, SC_NS) );
+    fabric->set_link( 16, sc_time(1, SC_NS) );
+
+    for (unsigned int i = 0; i < fabric->n_nodes(); i++)
+    {
+      ostringstream oss;
+      oss << "initiator_" << i;
+      initiator.push_back( new Streaming_initiator(oss.str().c_str(), n_trans, LENGTH) );
+      initiator[i]->set_address_range( 0, fabric->n_nodes() * NODE_SIZE );
+
+      oss.str("");
+      oss << "target_" << i;
+      target.push_back( new Pipelined_target(oss.str().c_str(), sc_time(1, SC_NS), sc_time(20, SC_NS), 0) );
+
+      initiator[i]->socket.bind( fabric->router(i)->targ_socket );
+      fabric->router(i)->init_socket.bind( target[i]->socket );
+    }
+  }
+};
+
+
+static void run( Noc_fabric::topology_t topology, unsigned int k, int n_trans )
+{
+  chrono::steady_clock::time_point t0 = chrono::steady_clock::now();
+
+  Top top("top", topology, k, n_trans);
+  sc_start();
+
+  chrono::steady_clock::time_point t1 = chrono::steady_clock::now();
+  double host_s = chrono::duration<double>(t1 - t0).count();
+
+  sc_time end = SC_ZERO_TIME;
+  for (unsigned int i = 0; i < top.initiator.size(); i++)
+  {
+    if (top.initiator[i]->n_done != n_trans)
+      SC_REPORT_ERROR("noc_bench", "Not all transactions completed");
+    if (top.initiator[i]->last_rsp > end)
+      end = top.initiator[i]->last_rsp;
+  }
+
+  double total = double(n_trans) * top.initiator.size();
+  double us    = end.to_seconds() * 1e6;
+
+  ostringstream size;
+  size << k << "x" << k;
+  cout << setw(8) << size.str()
+       << setw(8) << top.fabric->n_nodes()
+       << setw(10) << setprecision(2) << fixed << top.fabric->mean_hops()
+       << setw(14) << setprecision(1) << (us > 0 ? total / us : 0.0)
+       << setw(12) << 100.0 * top.fabric->peak_link_utilization()
+       << setw(12) << setprecision(3) << host_s
+       << setw(16) << setprecision(0) << (host_s > 0 ? total / host_s : 0.0)
+       << endl;
+}
+
+
+int sc_main(int argc, char* argv[])
+{
+  Noc_fabric::topology_t topology = Noc_fabric::MESH;
+  if (argc > 1 && string(argv[1]) == "ring")
+    topology = Noc_fabric::RING;
+
+  unsigned int k       = argc > 2 ? atoi(argv[2]) : 0;
+  int          n_trans = argc > 3 ? atoi(argv[3]) : 200;
+
+  cout << setw(8) << "size" << setw(8) << "nodes" << setw(10) << "hops"
+       << setw(14) << "trans/us sim" << setw(12) << "peak link %"
+       << setw(12) << "host s" << setw(16) << "trans/s host" << endl;
+
+  if (k)
+  {
+    run( topology, k, n_trans );
+    return 0;
+  }
+
+  unsigned int sizes[] = { 2, 4, 8, 16 };
+  for (unsigned int i = 0; i < sizeof(sizes) / sizeof(sizes[0]); i++)
+  {
+    cout.flush();
+    pid_t pid = fork();
+    if (pid == 0)
+    {
+      run( topology, sizes[i], n_trans );
+      cout.flush();
+      _exit(0);
+    }
+
+    int status;
+    waitpid( pid, &status, 0 );
+  }
+  return 0;
+}
@@ -0,0 +1,110 @@
+
+// Filename: outstanding_bench.cpp
+
+//----------------------------------------------------------------------
+//  Licensed under the Apache License, Version 2.0 (the "License");
+//  you may not use this file except in compliance with the License.
+//  You may obtain a copy of the License at
+//
+//  http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+//----------------------------------------------------------------------
+
+// Version 1  16-Oct-2026
+// Version 2  16-Oct-2026  Initiator and target moved to stream_modules.h
+
+/*
+
+Outstanding depth benchmark
+
+Measures how simulated throughput scales with the outstanding request window of
+AT_interconnect. Each row is an independent system of one streaming initiator, one
+interconnect and one pipelined target, all elaborated side by side and run in one simulation.
+
+The target accepts a request every nanosecond and responds after 100 ns plus a random
+jitter of up to 50 ns, so responses overtake one another whenever more than one request is in flight.
+With PASS_THROUGH the initiator sees these responses out of order; with IN_ORDER the
+interconnect parks them until the earlier responses have been delivered.
+
+Usage: out [n_transactions]
+
+*/
+
+#include "at_interconnect.h"
+#include "stream_modules.h"
+
+struct System: sc_module
+{
+  Streaming_initiator* initiator;
+  AT_interconnect*     interconnect;
+  Pipelined_target*    target;
+
+  tlm_utils::tlm2_base_protocol_checker<>* check_init;
+  tlm_utils::tlm2_base_protocol_checker<>* check_targ;
+
+  unsigned int depth;
+  AT_interconnect::response_order_t order;
+
+  System( sc_module_name name, int n_trans, unsigned int d, AT_interconnect::response_order_t o )
+  : depth(d)
+  , order(o)
+  {
+    initiator    = new Streaming_initiator("initiator", n_trans, 4);
+    interconnect = new AT_interconnect("interconnect");
+    target       = new Pipelined_target("target", sc_time(1, SC_NS), sc_time(100, SC_NS), 50);
+    check_init   = new tlm_utils::tlm2_base_protocol_checker<>("check_init");
+    check_targ   = new tlm_utils::tlm2_base_protocol_checker<>("check_targ");
+
+    interconnect->set_max_outstanding( 0, depth );
+    interconnect->set_response_order( 0, order );
+
+    initiator->socket.bind( check_init->target_socket );
+    check_init->initiator_socket.bind( interconnect->targ_socket );
+    interconnect->init_socket.bind( check_targ->target_socket );
+    check_targ->initiator_socket.bind( target->socket );
+  }
+};
+
+
+int sc_main(int argc, char* argv[])
+{
+  int n_trans = argc > 1 ? atoi(argv[1]) : 10000;
+
+  // A depth of 0 leaves the window unlimited
+  unsigned int depths[] = { 1, 2, 4, 8, 16, 32, 64, 128, 256, 0 };
+  const unsigned int n_depths = sizeof(depths) / sizeof(depths[0]);
+
+  std::vector<System*> systems;
+  for (unsigned int i = 0; i < n_depths; i++)
+    for (int o = 0; o < 2; o++)
+    {
+      ostringstream oss;
+      oss << "sys_" << depths[i] << (o ? "_in_order" : "_pass");
+      systems.push_back( new System( oss.str().c_str(), n_trans, depths[i],
+                                     o ? AT_interconnect::IN_ORDER : AT_interconnect::PASS_THROUGH ) );
+    }
+
+  sc_start();
+
+  cout << setw(8) << "depth" << setw(14) << "order" << setw(14) << "trans/us"
+       << setw(16) << "out of order" << endl;
+
+  for (unsigned int i = 0; i < systems.size(); i++)
+  {
+    System* s = systems[i];
+    if (s->initiator->n_done != n_trans)
+      SC_REPORT_ERROR("outstanding_bench", "Not all transactions completed");
+
+    double us = s->initiator->last_rsp.to_seconds() * 1e6;
+    cout << setw(8) << s->depth
+         << setw(14) << (s->order == AT_interconnect::IN_ORDER ? "in-order" : "pass-through")
+         << setw(14) << fixed << setprecision(2) << (us > 0 ? s->initiator->n_done / us : 0.0)
+         << setw(16) << s->initiator->n_out_of_order << endl;
+  }
+  return 0;
+}
@@ -0,0 +1,113 @@
+
+// Filename: paged_memory_bench.cpp
+
+//----------------------------------------------------------------------
+//  Licensed under the Apache License, Version 2.0 (the "License");
+//  you may not use this file except in compliance with the License.
+//  You may obtain a copy of the License at
+//
+//  http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+//----------------------------------------------------------------------
+
+// Version 1  16-Oct-2026
+
+/*
+
+Paged memory benchmark
+
+Shows that the cost of a Paged_memory follows the pages touched and not the declared
+size. Each row declares a memory of the given size, writes one word into each of
+n_pages randomly chosen pages, and reports the time to create the memory, the time of
+the writes, and the growth of the resident set.
+
+Usage: out [n_pages] [fill: zero, pattern or random]
+
+*/
+
+#include "paged_memory.h"
+
+#include <iostream>
+#include <iomanip>
+#include <fstream>
+#include <string>
+#include <chrono>
+#include <cstdlib>
+#include <unistd.h>
+
+using namespace std;
+
+
+// Resident set size of this process in bytes
+static sc_dt::uint64 resident_bytes()
+{
+  ifstream statm("/proc/self/statm");
+  sc_dt::uint64 size = 0, resident = 0;
+  statm >> size >> resident;
+  return resident * sysconf(_SC_PAGESIZE);
+}
+
+static double seconds_since( const chrono::steady_clock::time_point& start )
+{
+  return chrono::duration<double>( chrono::steady_clock::now() - start ).count();
+}
+
+
+int sc_main(int argc, char* argv[])
+{
+  unsigned int n_pages = argc > 1 ? atoi(argv[1]) : 4096;
+  string fill_name     = argc > 2 ? argv[2] : "random";
+
+  Paged_memory::fill_t fill = Paged_memory::RANDOM;
+  if (fill_name == "zero")
+    fill = Paged_memory::ZERO;
+  else if (fill_name == "pattern")
+    fill = Paged_memory::PATTERN;
+
+  cout << setw(10) << "size GB" << setw(14) << "create us" << setw(14) << "touch ms"
+       << setw(12) << "pages" << setw(14) << "RSS MB" << endl;
+
+  for (sc_dt::uint64 gb = 1; gb <= 64; gb *= 4)
+  {
+    sc_dt::uint64 size = gb << 30;
+    sc_dt::uint64 rss_before = resident_bytes();
+
+    chrono::steady_clock::time_point start = chrono::steady_clock::now();
+    Paged_memory memory( size, fill, 1 );
+    double create = seconds_since(start);
+
+    srand(1);
+    start = chrono::steady_clock::now();
+    for (unsigned int i = 0; i < n_pages; i++)
+    {
+      sc_dt::uint64 page = ((sc_dt::uint64(rand()) << 31) ^ rand()) % (size >> 12);
+      unsigned int word = i;
+      memory.write( page << 12, reinterpret_cast<unsigned char*>(&word), sizeof(word) );
+    }
+    double touch = seconds_since(start);
+
+    sc_dt::uint64 rss = resident_bytes() - rss_before;
+    cout << setw(10) << gb
+         << setw(14) << fixed << setprecision(1) << create * 1e6
+         << setw(14) << setprecision(2) << touch * 1e3
+         << setw(12) << memory.touched_pages()
+         << setw(14) << setprecision(1) << rss / double(1 << 20) << endl;
+  }
+
+  // A DMI pointer, once granted, stays valid however much of the memory is touched later
+  Paged_memory memory( sc_dt::uint64(16) << 30 );
+  sc_dt::uint64 start_address, end_address;
+  unsigned char* dmi = memory.dmi( 0x1000, start_address, end_address );
+  memory.write( 0x1000, reinterpret_cast<const unsigned char*>("DMI"), 4 );
+  for (unsigned int i = 1; i <= 1024; i++)
+    memory.data( sc_dt::uint64(i) << 24, 1 );
+  if (string( reinterpret_cast<char*>(dmi + 0x1000 - start_address) ) != "DMI")
+    SC_REPORT_ERROR("paged_memory_bench", "DMI pointer does not see the memory");
+
+  return 0;
+}
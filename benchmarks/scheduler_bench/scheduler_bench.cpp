@@ -0,0 +1,150 @@
+
+// Filename: scheduler_bench.cpp
+
+//----------------------------------------------------------------------
+//  Licensed under the Apache License, Version 2.0 (the "License");
+//  you may not use this file except in compliance with the License.
+//  You may obtain a copy of the License at
+//
+//  http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+//----------------------------------------------------------------------
+
+// Version 1  16-Oct-2026
+
+/*
+
+Interconnect scheduler benchmark
+
+Compares the two process structures of AT_interconnect: one method process per socket
+(PER_SOCKET) and one method process per interconnect driven by ready bitmaps (SINGLE).
+Builds n copies of the at_example system (4 initiators, 5 targets) for the selected
+scheduler, runs them to completion, and reports kernel process activations per
+transaction and the host time taken.
+
+Usage: out [per-socket|single|both] [n_systems]
+
+With "both", the two variants run side by side in the same simulation, so the activation
+counts are comparable but the host time covers both.
+
+*/
+
+#include "at_typea_initiator.h"
+#include "at_typeb_initiator.h"
+#include "at_interconnect.h"
+#include "at_typea_target.h"
+#include "at_typeb_target.h"
+#include "at_typec_target.h"
+#include "at_typed_target.h"
+#include "at_typee_target.h"
+
+#include <chrono>
+#include <cstring>
+
+
+struct System: sc_module
+{
+  AT_typeA_initiator *initiator0;
+  AT_typeA_initiator *initiator1;
+  AT_typeB_initiator *initiator2;
+  AT_typeB_initiator *initiator3;
+
+  AT_interconnect    *interconnect;
+
+  AT_typeA_target    *target0;
+  AT_typeB_target    *target1;
+  AT_typeC_target    *target2;
+  AT_typeD_target    *target3;
+  AT_typeE_target    *target4;
+
+  System( sc_module_name name, AT_interconnect::scheduler_t kind )
+  {
+    initiator0   = new AT_typeA_initiator("initiator0");
+    initiator1   = new AT_typeA_initiator("initiator1");
+    initiator2   = new AT_typeB_initiator("initiator2");
+    initiator3   = new AT_typeB_initiator("initiator3");
+
+    interconnect = new AT_interconnect("interconnect");
+    interconnect->set_scheduler( kind );
+
+    target0      = new AT_typeA_target("target0");
+    target1      = new AT_typeB_target("target1");
+    target2      = new AT_typeC_target("target2");
+    target3      = new AT_typeD_target("target3");
+    target4      = new AT_typeE_target("target4");
+
+    initiator0->socket.bind( interconnect->targ_socket );
+    initiator1->socket.bind( interconnect->targ_socket );
+    initiator2->socket.bind( interconnect->targ_socket );
+    initiator3->socket.bind( interconnect->targ_socket );
+
+    interconnect->init_socket.bind( target0->socket );
+    interconnect->init_socket.bind( target1->socket );
+    interconnect->init_socket.bind( target2->socket );
+    interconnect->init_socket.bind( target3->socket );
+    interconnect->init_socket.bind( target4->socket );
+  }
+};
+
+
+void report( const char* label, const std::vector<System*>& systems )
+{
+  if (systems.empty())
+    return;
+
+  sc_dt::uint64 activations = 0;
+  sc_dt::uint64 requests    = 0;
+  for (unsigned int i = 0; i < systems.size(); i++)
+  {
+    activations += systems[i]->interconnect->get_activations();
+    requests    += systems[i]->interconnect->get_requests();
+  }
+
+  cout << setw(12) << label
+       << setw(14) << activations
+       << setw(12) << requests
+       << setw(18) << fixed << setprecision(3) << double(activations) / requests << endl;
+}
+
+
+int sc_main(int argc, char* argv[])
+{
+  const char* mode = argc > 1 ? argv[1] : "both";
+  int n_systems    = argc > 2 ? atoi(argv[2]) : 8;
+
+  bool per_socket = strcmp(mode, "single") != 0;
+  bool single     = strcmp(mode, "per-socket") != 0;
+
+  std::vector<System*> per_socket_systems;
+  std::vector<System*> single_systems;
+
+  for (int i = 0; i < n_systems; i++)
+  {
+    ostringstream oss;
+    oss << i;
+    if (per_socket)
+      per_socket_systems.push_back( new System( ("per_socket_" + oss.str()).c_str(),
+                                                AT_interconnect::PER_SOCKET ) );
+    if (single)
+      single_systems.push_back( new System( ("single_" + oss.str()).c_str(),
+                                            AT_interconnect::SINGLE ) );
+  }
+
+  chrono::steady_clock::time_point t0 = chrono::steady_clock::now();
+  sc_start();
+  chrono::steady_clock::time_point t1 = chrono::steady_clock::now();
+
+  cout << setw(12) << "scheduler" << setw(14) << "activations" << setw(12) << "requests"
+       << setw(18) << "activations/req" << endl;
+
+  report( "per-socket", per_socket_systems );
+  report( "single",     single_systems );
+
+  cout << "host time " << chrono::duration<double>(t1 - t0).count() << " s" << endl;
+  return 0;
+}
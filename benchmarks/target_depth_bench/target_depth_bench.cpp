@@ -0,0 +1,92 @@
+
+// Filename: target_depth_bench.cpp
+
+//----------------------------------------------------------------------
+//  Licensed under the Apache License, Version 2.0 (the "License");
+//  you may not use this file except in compliance with the License.
+//  You may obtain a copy of the License at
+//
+//  http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+//----------------------------------------------------------------------
+
+// Version 1  16-Oct-2026
+
+/*
+
+Target pipeline depth benchmark
+
+Measures how throughput and latency change with the pipeline depth of AT_target_engine,
+as for a memory controller that can have many requests open at once. Each row is an
+independent system of one streaming initiator bound directly to one target, all
+elaborated side by side and run in one simulation.
+
+The target accepts a request after 1 ns and responds 100 ns later, so a depth of about
+100 is needed to keep it busy. The latency reported is from BEGIN_REQ to BEGIN_RESP, and
+includes the time a request waits for room in the pipeline.
+
+Usage: out [n_transactions]
+
+*/
+
+#include "at_target_engine.h"
+#include "stream_modules.h"
+
+
+struct System: sc_module
+{
+  Streaming_initiator* initiator;
+  AT_target_engine*    target;
+  Fixed_latency        latency;
+
+  System( sc_module_name name, int n_trans, unsigned int depth )
+  : latency( sc_time(1, SC_NS), sc_time(100, SC_NS) )
+  {
+    initiator = new Streaming_initiator("initiator", n_trans, 64);
+    target    = new AT_target_engine("target", depth, &latency);
+
+    initiator->socket.bind( target->socket );
+  }
+};
+
+
+int sc_main(int argc, char* argv[])
+{
+  int n_trans = argc > 1 ? atoi(argv[1]) : 10000;
+
+  unsigned int depths[] = { 1, 2, 4, 8, 16, 32, 64, 128, 256 };
+  const unsigned int n_depths = sizeof(depths) / sizeof(depths[0]);
+
+  std::vector<System*> systems;
+  for (unsigned int i = 0; i < n_depths; i++)
+  {
+    ostringstream oss;
+    oss << "sys_" << depths[i];
+    systems.push_back( new System( oss.str().c_str(), n_trans, depths[i] ) );
+  }
+
+  sc_start();
+
+  cout << setw(8) << "depth" << setw(14) << "trans/us" << setw(16) << "mean latency"
+       << setw(16) << "max latency" << setw(8) << "peak" << endl;
+
+  for (unsigned int i = 0; i < systems.size(); i++)
+  {
+    System* s = systems[i];
+    if (s->initiator->n_done != n_trans)
+      SC_REPORT_ERROR("target_depth_bench", "Not all transactions completed");
+
+    double us = s->initiator->last_rsp.to_seconds() * 1e6;
+    cout << setw(8) << s->target->get_depth()
+         << setw(14) << fixed << setprecision(2) << (us > 0 ? s->initiator->n_done / us : 0.0)
+         << setw(16) << s->target->mean_latency()
+         << setw(16) << s->target->max_latency
+         << setw(8) << s->target->peak_trans << endl;
+  }
+  return 0;
+}
@@ -0,0 +1,168 @@
+
+// Filename: trace_bench.cpp
+
+//----------------------------------------------------------------------
+//  Licensed under the Apache License, Version 2.0 (the "License");
+//  you may not use this file except in compliance with the License.
+//  You may obtain a copy of the License at
+//
+//  http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+//----------------------------------------------------------------------
+
+// Version 1  16-Oct-2026
+
+/*
+
+Trace replay benchmark
+
+Replays a binary memory-access trace (see trace_file.h, and tools/trace_convert to make
+one) into either an AT_interconnect or the Router of TLM-2.0-Tutorial-Example3, each
+driving a row of AT_target_engines, and reports the latency seen and how far the replay
+fell behind the recorded times.
+
+Settings, as key=value arguments after the trace:
+
+  protocol     at | lt (default at; the Router is always driven with lt)
+  rate         requests per microsecond, or 0 to keep the recorded times (default 0)
+  outstanding  most requests in flight, 0 for no limit (default 0)
+  router       1 to use the tutorial Router and its four targets (default 0)
+  targets      number of targets of the interconnect (default 4)
+  depth        pipeline depth of each target (default 16)
+  base, span   the addresses divided evenly between the targets of the interconnect
+               (default 0 and 0x100000000)
+  map          memory map file for the interconnect, instead of base and span
+
+Usage: out <trace> [key=value ...]
+
+*/
+
+#include "at_interconnect.h"
+#include "at_target_engine.h"
+#include "trace_replay.h"
+#include "router.h"
+
+
+struct System: sc_module
+{
+  Trace_replay*                  replay;
+  AT_interconnect*               interconnect;
+  Router<4>*                     router;
+  std::vector<AT_target_engine*> targets;
+  Fixed_latency                  latency;
+
+  System( sc_module_name name, const char* trace, Trace_replay::protocol_t protocol,
+          bool use_router, unsigned int n_targets, unsigned int depth,
+          sc_dt::uint64 base, sc_dt::uint64 span, const std::string& map )
+  : interconnect(0)
+  , router(0)
+  , latency( sc_time(1, SC_NS), sc_time(100, SC_NS) )
+  {
+    replay = new Trace_replay("replay", trace, use_router ? Trace_replay::LT : protocol);
+
+    if (use_router)
+    {
+      router = new Router<4>("router");
+      replay->socket.bind( router->target_socket );
+      n_targets = 4;
+    }
+    else
+    {
+      interconnect = new AT_interconnect("interconnect");
+      replay->socket.bind( interconnect->targ_socket );
+      if (!map.empty())
+        interconnect->load_memory_map( map.c_str() );
+    }
+
+    sc_dt::uint64 region = span / n_targets;
+    for (unsigned int i = 0; i < n_targets; i++)
+    {
+      ostringstream oss;
+      oss << "target_" << i;
+      targets.push_back( new AT_target_engine(oss.str().c_str(), depth, &latency) );
+
+      if (router)
+        router->initiator_socket[i]->bind( targets.back()->socket );
+      else
+      {
+        interconnect->init_socket.bind( targets.back()->socket );
+        if (map.empty())
+          interconnect->map_region( base + i * region, region, i );
+      }
+    }
+  }
+};
+
+
+int sc_main(int argc, char* argv[])
+{
+  if (argc < 2)
+  {
+    cerr << "Usage: " << argv[0] << " <trace> [key=value ...]" << endl;
+    return 1;
+  }
+
+  Trace_replay::protocol_t protocol = Trace_replay::AT;
+  double        rate        = 0;
+  unsigned int  outstanding = 0;
+  bool          use_router  = false;
+  unsigned int  n_targets   = 4;
+  unsigned int  depth       = 16;
+  sc_dt::uint64 base        = 0;
+  sc_dt::uint64 span        = 0x100000000ULL;
+  std::string   map;
+
+  for (int i = 2; i < argc; i++)
+  {
+    std::string arg = argv[i];
+    std::string::size_type eq = arg.find('=');
+    std::string key = arg.substr(0, eq);
+    const char* v   = eq == std::string::npos ? "" : argv[i] + eq + 1;
+
+    if      (key == "protocol")    protocol    = std::string(v) == "lt" ? Trace_replay::LT : Trace_replay::AT;
+    else if (key == "rate")        rate        = atof(v);
+    else if (key == "outstanding") outstanding = atoi(v);
+    else if (key == "router")      use_router  = atoi(v) != 0;
+    else if (key == "targets")     n_targets   = atoi(v);
+    else if (key == "depth")       depth       = atoi(v);
+    else if (key == "base")        base        = strtoull(v, 0, 0);
+    else if (key == "span")        span        = strtoull(v, 0, 0);
+    else if (key == "map")         map         = v;
+    else
+    {
+      std::string txt = "Unknown setting " + arg;
+      SC_REPORT_FATAL("trace_bench", txt.c_str());
+    }
+  }
+  if (n_targets == 0 || span < n_targets)
+    SC_REPORT_FATAL("trace_bench", "Need at least one target, and a span of at least a byte each");
+
+  System* system = new System("system", argv[1], protocol, use_router, n_targets, depth, base, span, map);
+  system->replay->set_rate( rate );
+  system->replay->set_outstanding( outstanding );
+
+  sc_start();
+
+  Trace_replay* r = system->replay;
+  if (!r->finished())
+    SC_REPORT_ERROR("trace_bench", "Not all transactions completed");
+
+  double us = r->last_rsp > r->first_req ? (r->last_rsp - r->first_req).to_seconds() * 1e6 : 0.0;
+  cout << r->n_done << " accesses, " << r->n_errors << " errors, "
+       << fixed << setprecision(2) << (us > 0 ? r->bytes / us : 0.0) << " bytes/us" << endl;
+  cout << "latency mean " << r->mean_latency() << ", max " << r->max_latency
+       << ", replay at most " << r->max_lag << " behind the trace" << endl;
+
+  for (unsigned int i = 0; i < system->targets.size(); i++)
+  {
+    AT_target_engine* t = system->targets[i];
+    cout << t->basename() << ": " << t->n_responses << " responses, mean latency "
+         << t->mean_latency() << ", peak depth " << t->peak_trans << endl;
+  }
+  return 0;
+}
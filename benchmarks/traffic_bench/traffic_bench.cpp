@@ -0,0 +1,164 @@
+
+// Filename: traffic_bench.cpp
+
+//----------------------------------------------------------------------
+//  Licensed under the Apache License, Version 2.0 (the "License");
+//  you may not use this file except in compliance with the License.
+//  You may obtain a copy of the License at
+//
+//  http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+//----------------------------------------------------------------------
+
+// Version 1  16-Oct-2026
+
+/*
+
+Traffic generator benchmark
+
+Drives an AT_interconnect and a row of AT_target_engines with traffic generators, to
+measure the bandwidth and latency of the system under a given load. Every generator runs
+the same Traffic_config (see traffic_generator.h), each drawing its own random numbers.
+The span of addresses [base, base + span) is divided evenly between the targets.
+
+Besides the settings of Traffic_config, the system is set by
+
+  initiators   number of traffic generators (default 4)
+  targets      number of targets (default 4)
+  depth        pipeline depth of each target (default 16)
+  accept_ns    delay from BEGIN_REQ to END_REQ in each target (default 1)
+  latency_ns   delay from END_REQ to BEGIN_RESP in each target (default 100)
+  seed         global seed of the random streams (default 0)
+
+Usage: out [config file] [key=value ...]
+
+for example
+
+  out traffic.cfg
+  out pattern=hot_spot outstanding=8 rate=50 n_trans=100000
+
+*/
+
+#include "at_interconnect.h"
+#include "at_target_engine.h"
+#include "traffic_generator.h"
+
+
+struct Bench_config: Traffic_config
+{
+  Bench_config()
+  : initiators(4)
+  , targets(4)
+  , depth(16)
+  , accept(1, SC_NS)
+  , latency(100, SC_NS)
+  {}
+
+  virtual bool parse( const std::string& key, const std::string& value )
+  {
+    const char* v = value.c_str();
+    if      (key == "initiators") initiators = atoi(v);
+    else if (key == "targets")    targets    = atoi(v);
+    else if (key == "depth")      depth      = atoi(v);
+    else if (key == "accept_ns")  accept     = sc_time(atof(v), SC_NS);
+    else if (key == "latency_ns") latency    = sc_time(atof(v), SC_NS);
+    else if (key == "seed")       Random_stream::set_global_seed( strtoull(v, 0, 0) );
+    else
+      return Traffic_config::parse(key, value);
+    return true;
+  }
+
+  unsigned int initiators;
+  unsigned int targets;
+  unsigned int depth;
+  sc_time      accept;
+  sc_time      latency;
+};
+
+
+struct System: sc_module
+{
+  std::vector<Traffic_generator*> generators;
+  AT_interconnect*                interconnect;
+  std::vector<AT_target_engine*>  targets;
+  Fixed_latency                   latency;
+
+  System( sc_module_name name, const Bench_config& cfg )
+  : latency( cfg.accept, cfg.latency )
+  {
+    interconnect = new AT_interconnect("interconnect");
+
+    for (unsigned int i = 0; i < cfg.initiators; i++)
+    {
+      ostringstream oss;
+      oss << "generator_" << i;
+      generators.push_back( new Traffic_generator(oss.str().c_str(), cfg) );
+      generators.back()->socket.bind( interconnect->targ_socket );
+    }
+
+    sc_dt::uint64 region = (cfg.span + cfg.targets - 1) / cfg.targets;
+    for (unsigned int i = 0; i < cfg.targets; i++)
+    {
+      ostringstream oss;
+      oss << "target_" << i;
+      targets.push_back( new AT_target_engine(oss.str().c_str(), cfg.depth, &latency) );
+      interconnect->init_socket.bind( targets.back()->socket );
+      interconnect->map_region( cfg.base + i * region, region, i );
+    }
+  }
+};
+
+
+int sc_main(int argc, char* argv[])
+{
+  Bench_config cfg;
+  cfg.parse_args(argc, argv);
+
+  if (cfg.initiators == 0 || cfg.targets == 0)
+    SC_REPORT_FATAL("traffic_bench", "There must be at least one initiator and one target");
+
+  System* system = new System("system", cfg);
+
+  sc_start();
+
+  cout << setw(16) << "generator" << setw(12) << "trans" << setw(10) << "errors"
+       << setw(14) << "bytes/us" << setw(16) << "mean latency" << setw(16) << "max latency" << endl;
+
+  sc_dt::uint64 n_done = 0, bytes = 0;
+  sc_time first = sc_max_time(), last = SC_ZERO_TIME;
+
+  for (unsigned int i = 0; i < system->generators.size(); i++)
+  {
+    Traffic_generator* g = system->generators[i];
+    if (!g->finished())
+      SC_REPORT_ERROR("traffic_bench", "Not all transactions completed");
+
+    cout << setw(16) << g->basename() << setw(12) << g->n_done << setw(10) << g->n_errors
+         << setw(14) << fixed << setprecision(2) << g->bandwidth()
+         << setw(16) << g->mean_latency() << setw(16) << g->max_latency << endl;
+
+    n_done += g->n_done;
+    bytes  += g->bytes;
+    if (g->n_issued && g->first_req < first)
+      first = g->first_req;
+    if (g->last_rsp > last)
+      last = g->last_rsp;
+  }
+
+  double us = last > first ? (last - first).to_seconds() * 1e6 : 0.0;
+  cout << setw(16) << "total" << setw(12) << n_done << setw(10) << ""
+       << setw(14) << (us > 0 ? bytes / us : 0.0) << endl;
+
+  for (unsigned int i = 0; i < system->targets.size(); i++)
+  {
+    AT_target_engine* t = system->targets[i];
+    cout << t->basename() << ": " << t->n_responses << " responses, mean latency "
+         << t->mean_latency() << ", peak depth " << t->peak_trans << endl;
+  }
+  return 0;
+}
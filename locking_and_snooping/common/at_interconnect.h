@@ -18,6 +18,7 @@
 //----------------------------------------------------------------------
 
 // Version 1  09-Sep-2008
+// Version 2  16-Oct-2026  Phases noted for memory manager accounting
 
 
 #ifndef __AT_INTERCONNECT_H__
@@ -101,6 +102,8 @@ struct AT_interconnect: sc_module
   virtual tlm::tlm_sync_enum nb_transport_fw( int id, tlm::tlm_generic_payload& trans,
                                               tlm::tlm_phase& phase, sc_time& delay )
   {
+    MM_ACCOUNT( note_phase(trans, phase) );
+
     unsigned int target = 0;
 
     // Sticky extension, survives the transaction pool
@@ -225,6 +228,8 @@ struct AT_interconnect: sc_module
   virtual tlm::tlm_sync_enum nb_transport_bw( int id, tlm::tlm_generic_payload& trans,
                                               tlm::tlm_phase& phase, sc_time& delay )
   {
+    MM_ACCOUNT( note_phase(trans, phase) );
+
     if (phase == tlm::END_REQ || (&trans == req_in_progress[id] && phase == tlm::BEGIN_RESP))
     {
       assert( req_in_progress[id] );
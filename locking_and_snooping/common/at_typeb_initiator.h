@@ -19,6 +19,9 @@
 
 // Version 1  09-Sep-2008
 // Version 2  03-Jul-2009 Hacked for lock_interconnect example
+// Version 3  16-Oct-2026 Data storage owned by the payload
+// Version 4  16-Oct-2026 Transactions recorded in the transaction log
+// Version 5  16-Oct-2026 Random numbers from a stream of its own
 
 
 #ifndef __AT_TYPEB_INITIATOR_H__
@@ -39,6 +42,7 @@ struct AT_typeB_initiator: sc_module
   , m_mm(mm)
   , req_in_progress(0)
   , m_peq(this, &AT_typeB_initiator::peq_cb)
+  , m_random(name())
   {
     socket.register_nb_transport_bw(this, &AT_typeB_initiator::nb_transport_bw);
 
@@ -56,18 +60,21 @@ struct AT_typeB_initiator: sc_module
     // Generate a sequence of random transactions
     for (int i = 0; i < 1000; i++)
     {
-      int adr = rand() & 0xFFFC; // Address is word-aligned
+      int adr = m_random.below(0x10000) & 0xFFFC; // Address is word-aligned
 
-      tlm::tlm_command cmd = static_cast<tlm::tlm_command>(rand() % 2);
-      if (cmd == tlm::TLM_WRITE_COMMAND) data[i % 16] = adr;
+      tlm::tlm_command cmd = static_cast<tlm::tlm_command>(m_random.below(2));
 
       // Grab a new transaction from the memory manager
       trans = m_mm->allocate();
       trans->acquire();
 
+      // The payload carries its own data, so any number of transactions may be in flight
+      int* data = reinterpret_cast<int*>( m_mm->data(trans, 4) );
+      if (cmd == tlm::TLM_WRITE_COMMAND) *data = adr;
+
       trans->set_command( cmd );
       trans->set_address( adr );
-      trans->set_data_ptr( reinterpret_cast<unsigned char*>(&data[i % 16]) );
+      trans->set_data_ptr( reinterpret_cast<unsigned char*>(data) );
       trans->set_data_length( 4 );
       trans->set_streaming_width( 4 );
       trans->set_byte_enable_ptr( 0 );
@@ -81,11 +88,9 @@ struct AT_typeB_initiator: sc_module
       phase = tlm::BEGIN_REQ;
 
       // Timing annotation models processing time of initiator prior to call
-      delay = sc_time(rand_ps(), SC_PS);
+      delay = sc_time(rand_ps(m_random), SC_PS);
 
-      fout << hex << adr << " new, cmd=" << (cmd ? "write" : "read")
-           << ", data=" << hex << data[i % 16] << " at time " << sc_time_stamp()
-           << " in " << name() << endl;
+      trans_log.record( this, Transaction_record::NEW, cmd, adr, *data );
 
       // Non-blocking transport call on the forward path
       tlm::tlm_sync_enum status;
@@ -108,7 +113,7 @@ struct AT_typeB_initiator: sc_module
         // Allow the memory manager to free the transaction object
         trans->release();
       }
-      wait( sc_time(rand_ps(), SC_PS) );
+      wait( sc_time(rand_ps(m_random), SC_PS) );
     }
   }
 
@@ -133,7 +138,7 @@ struct AT_typeB_initiator: sc_module
 
       check_transaction( trans );
       trans.release();
-      delay = delay + sc_time(rand_ps(), SC_PS);
+      delay = delay + sc_time(rand_ps(m_random), SC_PS);
       return tlm::TLM_COMPLETED;
     }
     else
@@ -162,7 +167,7 @@ struct AT_typeB_initiator: sc_module
 
       // Send final phase transition to target
       tlm::tlm_phase fw_phase = tlm::END_RESP;
-      sc_time delay = sc_time(rand_ps(), SC_PS);
+      sc_time delay = sc_time(rand_ps(m_random), SC_PS);
       socket->nb_transport_fw( trans, fw_phase, delay );
       // Ignore return value
 
@@ -180,26 +185,25 @@ struct AT_typeB_initiator: sc_module
       sprintf(txt, "Transaction returned with error, response status = %s",
                    trans.get_response_string().c_str());
       //SC_REPORT_INFO("TLM-2", txt);
-      fout << txt << "\n... ";
+      trans_log.record( this, Transaction_record::ERROR, trans.get_command(), trans.get_address(),
+                        trans.get_response_status() );
     }
 
     tlm::tlm_command cmd = trans.get_command();
     sc_dt::uint64    adr = trans.get_address();
     int*             ptr = reinterpret_cast<int*>( trans.get_data_ptr() );
 
-    fout << hex << adr << " check, cmd=" << (cmd ? "write" : "read")
-         << ", data=" << hex << *ptr << " at time " << sc_time_stamp()
-         << " in " << name() << endl;
+    trans_log.record( this, Transaction_record::CHECK, cmd, adr, *ptr );
 
     if (cmd == tlm::TLM_READ_COMMAND && trans.is_response_ok() )
       assert( *ptr == -int(adr) );
   }
 
   gp_mm* m_mm;
-  int    data[16];
   tlm::tlm_generic_payload* req_in_progress;
   sc_event end_req_event;
   tlm_utils::peq_with_cb_and_phase<AT_typeB_initiator> m_peq;
+  Random_stream m_random;
 };
 
 #endif
@@ -18,215 +18,55 @@
 //----------------------------------------------------------------------
 
 // Version 1  09-Sep-2008
+// Version 2  16-Oct-2026  Burst and byte-enable transfers
+// Version 3  16-Oct-2026  Protocol handling moved to AT_target_engine
+// Version 4  16-Oct-2026  Transactions recorded in the transaction log
 
 
 #ifndef __AT_TYPEB_TARGET_H__
 #define __AT_TYPEB_TARGET_H__
 
 #include "../common/common_header.h"
+#include "at_target_engine.h"
 
-struct AT_typeB_target: sc_module
+struct AT_typeB_target: AT_target_engine
 {
   // The typeB target returns END_REQ on the return path unless forbidden by the
   // request exclusion rule, in which case it sends END_REQ on the backward path
 
-  tlm_utils::simple_target_socket<AT_typeB_target, 32> socket;
+  // Up to depth transactions are in the pipeline at once (see at_target_engine.h)
 
-  SC_CTOR(AT_typeB_target)
-  : socket("socket")
-  , n_trans(0)
-  , response_in_progress(false)
-  , next_response_pending(0)
-  , end_req_pending(0)
-  , m_peq(this, &AT_typeB_target::peq_cb)
+  AT_typeB_target( sc_module_name name, unsigned int depth = 2, Target_latency* latency = 0 )
+  : AT_target_engine(name, depth, latency)
   {
-    socket.register_nb_transport_fw(this, &AT_typeB_target::nb_transport_fw);
+    set_return_path(true);
   }
 
-  virtual tlm::tlm_sync_enum nb_transport_fw( tlm::tlm_generic_payload& trans,
-                                              tlm::tlm_phase& phase, sc_time& delay )
+  virtual bool check_request( tlm::tlm_generic_payload& trans )
   {
-    unsigned int     len = trans.get_data_length();
-    unsigned char*   byt = trans.get_byte_enable_ptr();
-    unsigned int     wid = trans.get_streaming_width();
-
-    if (byt != 0) {
-      trans.set_response_status( tlm::TLM_BYTE_ENABLE_ERROR_RESPONSE );
-      return tlm::TLM_COMPLETED;
-    }
-    if (len > 4 || wid < len) {
-      trans.set_response_status( tlm::TLM_BURST_ERROR_RESPONSE );
-      return tlm::TLM_COMPLETED;
-    }
-
-    if (phase == tlm::BEGIN_REQ)
-    {
-      if (n_trans < 2)
-      {
-        trans.acquire();
-
-        // Queue the acceptance and the response with the appropriate latency
-        phase = tlm::END_REQ;
-        delay = delay + sc_time(rand_ps(), SC_PS); // Accept delay
-
-        // Queue internal event to mark beginning of response
-        tlm::tlm_phase int_phase = internal_ph;
-        sc_time int_delay = delay + sc_time(rand_ps(), SC_PS); // Latency
-        m_peq.notify( trans, int_phase, int_delay );
-
-        n_trans++;
-        return tlm::TLM_UPDATED;
-      }
-    }
-
-    m_peq.notify( trans, phase, delay);
-    return tlm::TLM_ACCEPTED;
+    return check_burst(trans);
   }
 
-  void peq_cb(tlm::tlm_generic_payload& trans, const tlm::tlm_phase& phase)
+  virtual void execute( tlm::tlm_generic_payload& trans )
   {
-    sc_time delay;
-
-    switch (phase) {
-    case tlm::BEGIN_REQ:
-
-      trans.acquire();
-
-      // Put back-pressure on initiator by deferring END_REQ until pipeline is clear
-      if (n_trans == 2)
-        end_req_pending = &trans;
-      else
-      {
-        send_end_req(trans);
-      }
-
-      break;
-
-    case tlm::END_RESP:
-      // On receiving END_RESP, the target can release the transaction
-      // and allow other pending transactions to proceed
-
-      if (!response_in_progress)
-        SC_REPORT_FATAL("TLM-2", "Illegal transaction phase END_RESP received by target");
-
-      trans.release();
-      n_trans--;
-
-      // Target itself is now clear to issue the next BEGIN_RESP
-      response_in_progress = false;
-      if (next_response_pending)
-      {
-        send_response( *next_response_pending );
-        next_response_pending = 0;
-      }
-
-      // ... and to unblock the initiator by issuing END_REQ
-      if (end_req_pending)
-      {
-        send_end_req( *end_req_pending );
-        end_req_pending = 0;
-      }
-
-      break;
-
-    case tlm::END_REQ:
-    case tlm::BEGIN_RESP:
-      SC_REPORT_FATAL("TLM-2", "Illegal transaction phase received by target");
-      break;
-
-    default:
-      if (phase == internal_ph)
-      {
-        tlm::tlm_command cmd = trans.get_command();
-        sc_dt::uint64    adr = trans.get_address();
-        unsigned char*   ptr = trans.get_data_ptr();
-
-        if ( cmd == tlm::TLM_READ_COMMAND )
-        {
-          *reinterpret_cast<int*>(ptr) = -int(adr);
-          fout << hex << adr << " Execute READ, data = " << *reinterpret_cast<int*>(ptr)
-               << " in " << name() << endl;
-        }
-        else if ( cmd == tlm::TLM_WRITE_COMMAND )
-          fout << hex << adr << " Execute WRITE, data = " << *reinterpret_cast<int*>(ptr)
-               << " in " << name() << endl;
-
-        trans.set_response_status( tlm::TLM_OK_RESPONSE );
-
-        // Target must honor BEGIN_RESP/END_RESP exclusion rule
-        // i.e. must not send BEGIN_RESP until receiving previous END_RESP or BEGIN_REQ
-        if (response_in_progress)
-        {
-          // Target allows only two transactions in-flight
-          if (next_response_pending)
-            SC_REPORT_FATAL("TLM-2", "Attempt to have two pending responses in target");
-          next_response_pending = &trans;
-        }
-        else
-          send_response(trans);
-        break;
-      }
-    }
-  }
+    tlm::tlm_command cmd = trans.get_command();
+    sc_dt::uint64    adr = trans.get_address();
 
-  void send_end_req(tlm::tlm_generic_payload& trans)
-  {
-    tlm::tlm_phase bw_phase;
-    tlm::tlm_phase int_phase = internal_ph;
-    sc_time delay;
-
-    // Queue the acceptance and the response with the appropriate latency
-    bw_phase = tlm::END_REQ;
-    delay = sc_time(rand_ps(), SC_PS); // Accept delay
-    socket->nb_transport_bw( trans, bw_phase, delay );
-    // Ignore return value; initiator cannot terminate transaction at this point
-
-    // Queue internal event to mark beginning of response
-    delay = delay + sc_time(rand_ps(), SC_PS); // Latency
-    m_peq.notify( trans, int_phase, delay );
-    n_trans++;
-  }
-
-  void send_response(tlm::tlm_generic_payload& trans)
-  {
-    tlm::tlm_sync_enum status;
-    tlm::tlm_phase bw_phase;
-    sc_time delay;
-
-    response_in_progress = true;
-    bw_phase = tlm::BEGIN_RESP;
-    delay = SC_ZERO_TIME;
-    status = socket->nb_transport_bw( trans, bw_phase, delay );
-
-    if (status == tlm::TLM_UPDATED)
+    if ( cmd == tlm::TLM_READ_COMMAND )
     {
-      // The timing annotation must be honored
-      m_peq.notify( trans, bw_phase, delay);
+      execute_read( trans );
+      trans_log.record( this, Transaction_record::EXECUTE, cmd, adr, first_word(trans) );
     }
-    else if (status == tlm::TLM_COMPLETED)
-    {
-      // The initiator has terminated the transaction
+    else if ( cmd == tlm::TLM_WRITE_COMMAND )
+      trans_log.record( this, Transaction_record::EXECUTE, cmd, adr, first_word(trans) );
 
-      assert( response_in_progress );
-
-      trans.release();
-      n_trans--;
-      response_in_progress = false;
-
-      // Target is now clear to unblock the initiator by issuing END_REQ
-      if (end_req_pending)
-      {
-        send_end_req( *end_req_pending );
-        end_req_pending = 0;
-      }
-    }
+    trans.set_response_status( tlm::TLM_OK_RESPONSE );
   }
 
-  int   n_trans;
-  bool  response_in_progress;
-  tlm::tlm_generic_payload*  next_response_pending;
-  tlm::tlm_generic_payload*  end_req_pending;
-  tlm_utils::peq_with_cb_and_phase<AT_typeB_target> m_peq;
+  virtual sc_time transfer_latency( const tlm::tlm_generic_payload& trans )
+  {
+    return burst_latency(trans);
+  }
 };
 
 #endif
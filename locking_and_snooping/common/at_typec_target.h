@@ -18,6 +18,9 @@
 //----------------------------------------------------------------------
 
 // Version 1  09-Sep-2008
+// Version 2  16-Oct-2026  Burst and byte-enable transfers
+// Version 3  16-Oct-2026  Transactions recorded in the transaction log
+// Version 4  16-Oct-2026  Random numbers from a stream of its own
 
 
 #ifndef __AT_TYPEC_TARGET_H__
@@ -36,6 +39,7 @@ struct AT_typeC_target: sc_module
   , response_in_progress(false)
   , next_response_pending(0)
   , m_peq(this, &AT_typeC_target::peq_cb)
+  , m_random(name())
   {
     socket.register_nb_transport_fw(this, &AT_typeC_target::nb_transport_fw);
   }
@@ -43,18 +47,8 @@ struct AT_typeC_target: sc_module
   virtual tlm::tlm_sync_enum nb_transport_fw( tlm::tlm_generic_payload& trans,
                                               tlm::tlm_phase& phase, sc_time& delay )
   {
-    unsigned int     len = trans.get_data_length();
-    unsigned char*   byt = trans.get_byte_enable_ptr();
-    unsigned int     wid = trans.get_streaming_width();
-
-    if (byt != 0) {
-      trans.set_response_status( tlm::TLM_BYTE_ENABLE_ERROR_RESPONSE );
-      return tlm::TLM_COMPLETED;
-    }
-    if (len > 4 || wid < len) {
-      trans.set_response_status( tlm::TLM_BURST_ERROR_RESPONSE );
+    if ( !check_burst(trans) )
       return tlm::TLM_COMPLETED;
-    }
 
     m_peq.notify( trans, phase, delay);
     return tlm::TLM_ACCEPTED;
@@ -70,7 +64,7 @@ struct AT_typeC_target: sc_module
       trans.acquire();
 
       tlm::tlm_phase int_phase = internal_ph;
-      delay = sc_time(rand_ps(), SC_PS); // Latency
+      delay = sc_time(rand_ps(m_random), SC_PS) + burst_latency(trans); // Latency
 
       // Queue internal event to mark beginning of response
       m_peq.notify( trans, int_phase, delay );
@@ -105,17 +99,14 @@ struct AT_typeC_target: sc_module
       {
         tlm::tlm_command cmd = trans.get_command();
         sc_dt::uint64    adr = trans.get_address();
-        unsigned char*   ptr = trans.get_data_ptr();
 
         if ( cmd == tlm::TLM_READ_COMMAND )
         {
-          *reinterpret_cast<int*>(ptr) = -int(adr);
-          fout << hex << adr << " Execute READ, data = " << *reinterpret_cast<int*>(ptr)
-               << " in " << name() << endl;
+          execute_read( trans );
+          trans_log.record( this, Transaction_record::EXECUTE, cmd, adr, first_word(trans) );
         }
         else if ( cmd == tlm::TLM_WRITE_COMMAND )
-          fout << hex << adr << " Execute WRITE, data = " << *reinterpret_cast<int*>(ptr)
-               << " in " << name() << endl;
+          trans_log.record( this, Transaction_record::EXECUTE, cmd, adr, first_word(trans) );
 
         trans.set_response_status( tlm::TLM_OK_RESPONSE );
 
@@ -163,6 +154,7 @@ struct AT_typeC_target: sc_module
 
   tlm::tlm_generic_payload*  next_response_pending;
   tlm_utils::peq_with_cb_and_phase<AT_typeC_target> m_peq;
+  Random_stream m_random;
 };
 
 #endif
@@ -0,0 +1,162 @@
+
+// Filename: burst.h
+
+//----------------------------------------------------------------------
+//  Licensed under the Apache License, Version 2.0 (the "License");
+//  you may not use this file except in compliance with the License.
+//  You may obtain a copy of the License at
+//
+//  http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+//----------------------------------------------------------------------
+
+// Version 1  16-Oct-2026
+// Version 2  16-Oct-2026  first_word() for logging transfers of any length
+
+
+// *******************************************************************
+// Burst and byte-enable execution shared by the example targets
+// *******************************************************************
+
+/*
+The example targets have no storage. A read returns, in every aligned 32-bit word, minus the
+address of that word, and a write is only logged. A transaction may be any number of bytes
+long, with a streaming width and byte enables as defined by the generic payload:
+
+  byte i of the data array is at address  adr + (i % streaming_width)
+  byte i is transferred if                byte_enable[i % byte_enable_length] == 0xff
+
+Byte enables are applied with masked_copy, which blends eight bytes at a time using the byte
+enable array directly as the mask, so that the compiler can vectorize the loop.
+
+A transaction is one beat per BEAT_BYTES bytes, and every beat after the first adds BEAT_PS
+to the latency of the target.
+*/
+
+#ifndef __BURST_H__
+#define __BURST_H__
+
+#include "tlm.h"
+
+#include <vector>
+#include <cstring>
+
+static const unsigned int BEAT_BYTES = 4;
+static const int          BEAT_PS    = 1000;
+
+// Check the attributes of a transaction. On failure, sets the response status and returns false
+inline bool check_burst( tlm::tlm_generic_payload& trans )
+{
+  if (trans.get_byte_enable_ptr() != 0 && trans.get_byte_enable_length() == 0)
+  {
+    trans.set_response_status( tlm::TLM_BYTE_ENABLE_ERROR_RESPONSE );
+    return false;
+  }
+  if (trans.get_data_length() == 0 || trans.get_streaming_width() == 0)
+  {
+    trans.set_response_status( tlm::TLM_BURST_ERROR_RESPONSE );
+    return false;
+  }
+  return true;
+}
+
+inline unsigned int burst_beats( const tlm::tlm_generic_payload& trans )
+{
+  return (trans.get_data_length() + BEAT_BYTES - 1) / BEAT_BYTES;
+}
+
+// Latency added by the beats after the first
+inline sc_core::sc_time burst_latency( const tlm::tlm_generic_payload& trans )
+{
+  return sc_core::sc_time( (burst_beats(trans) - 1) * BEAT_PS, sc_core::SC_PS );
+}
+
+// Copy n bytes from src to dst, keeping the bytes of dst whose byte enable is 0x00.
+// be[i] is the byte enable of byte i, and must be 0x00 or 0xff
+inline void masked_copy( unsigned char* dst, const unsigned char* src, unsigned int n,
+                         const unsigned char* be )
+{
+  unsigned int i = 0;
+  for ( ; i + 8 <= n; i += 8)
+  {
+    sc_dt::uint64 d, s, m;
+    memcpy(&d, dst + i, 8);
+    memcpy(&s, src + i, 8);
+    memcpy(&m, be  + i, 8);
+    d = (d & ~m) | (s & m);
+    memcpy(dst + i, &d, 8);
+  }
+  for ( ; i < n; i++)
+    dst[i] = (dst[i] & ~be[i]) | (src[i] & be[i]);
+}
+
+// Fill buf with the read data of the n bytes starting at address adr
+inline void fill_read_data( unsigned char* buf, sc_dt::uint64 adr, unsigned int n )
+{
+  for (unsigned int i = 0; i < n; )
+  {
+    sc_dt::uint64 a = adr + i;
+    int word = -int(a & ~sc_dt::uint64(3));
+    const unsigned char* w = reinterpret_cast<const unsigned char*>(&word);
+
+    for (unsigned int b = (unsigned int)(a & 3); b < 4 && i < n; b++, i++)
+      buf[i] = w[b];
+  }
+}
+
+// Execute a read, honoring the streaming width and byte enables of the transaction
+inline void execute_read( tlm::tlm_generic_payload& trans )
+{
+  unsigned char* ptr = trans.get_data_ptr();
+  unsigned int   len = trans.get_data_length();
+  unsigned int   wid = trans.get_streaming_width();
+  unsigned char* byt = trans.get_byte_enable_ptr();
+  unsigned int   bel = trans.get_byte_enable_length();
+
+  if (wid > len)
+    wid = len;
+
+  if (!byt)
+  {
+    // One pass over the streaming window, then repeat it for each further beat
+    fill_read_data( ptr, trans.get_address(), wid );
+    for (unsigned int i = wid; i < len; i += wid)
+      memcpy( ptr + i, ptr, (len - i < wid) ? len - i : wid );
+    return;
+  }
+
+  static std::vector<unsigned char> src;
+  static std::vector<unsigned char> mask;
+  src.resize(len);
+  fill_read_data( &src[0], trans.get_address(), wid );
+  for (unsigned int i = wid; i < len; i += wid)
+    memcpy( &src[i], &src[0], (len - i < wid) ? len - i : wid );
+
+  const unsigned char* be = byt;
+  if (bel < len)
+  {
+    // Repeat the byte enable pattern over the whole data array
+    mask.resize(len);
+    for (unsigned int i = 0; i < len; i += bel)
+      memcpy( &mask[i], byt, (len - i < bel) ? len - i : bel );
+    be = &mask[0];
+  }
+  masked_copy( ptr, &src[0], len, be );
+}
+
+// The first data word of a transaction, for logging. Transfers of fewer than four bytes are
+// zero-extended, and the data pointer need not be aligned
+inline unsigned int first_word( const tlm::tlm_generic_payload& trans )
+{
+  unsigned int word = 0;
+  unsigned int len  = trans.get_data_length();
+  memcpy( &word, trans.get_data_ptr(), len < 4 ? len : 4 );
+  return word;
+}
+
+#endif
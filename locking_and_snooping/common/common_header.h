@@ -19,6 +19,9 @@
 
 // Version 1  09-Sep-2008
 // Version 2  03-Jul-2009
+// Version 3  16-Oct-2026  Include burst.h
+// Version 4  16-Oct-2026  Transaction log
+// Version 5  16-Oct-2026  Random delays drawn from a stream per module
 
 
 #ifndef __COMMON_HEADER_H__
@@ -42,6 +45,9 @@ using namespace std;
 
 #include "../common/gp_mm.h"
 #include "../common/tlm2_base_protocol_checker.h"
+#include "../common/burst.h"
+#include "../common/transaction_log.h"
+#include "../common/random_source.h"
 
 #include <iomanip>
 #include <deque>
@@ -49,12 +55,15 @@ using namespace std;
 
 static ofstream fout("example.log");
 
+// Records the events of the initiators and targets, by default as text in fout
+static Transaction_log trans_log(fout);
+
 // Generate a random delay (with power-law distribution) to aid testing and stress the protocol
-int rand_ps()
+// Each module passes its own stream, so that its delays do not depend on the other modules
+int rand_ps( Random_stream& random )
 {
-  int n = rand() % 100;
-  n = n * n * n;
-  return n / 100;
+  double u = random.uniform();
+  return int(u * u * u * 9703);
 }
 
 DECLARE_EXTENDED_PHASE(internal_ph);
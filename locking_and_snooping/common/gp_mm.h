@@ -18,6 +18,9 @@
 //----------------------------------------------------------------------
 
 // Version 1  03-Jul-2009
+// Version 2  16-Oct-2026  Payloads come from a Slab_pool
+// Version 3  16-Oct-2026  Optional accounting hooks, see mm_accounting.h
+// Version 4  16-Oct-2026  Data storage owned by each payload
 
 
 // *******************************************************************
@@ -28,6 +31,8 @@
 #define __GP_MM_H__
 
 #include "tlm.h"
+#include "slab_pool.h"
+#include "mm_accounting.h"
 
 class gp_mm: public tlm::tlm_mm_interface
 {
@@ -35,79 +40,35 @@ private:
   typedef tlm::tlm_generic_payload gp_t;
 
 public:
-  gp_mm() : free_list(0), empties(0) {}
+  // A warning is issued if more than capacity payloads are live at once (0 = no bound)
+  gp_mm( unsigned int capacity = 0 ) : pool(this, capacity) {}
 
-  virtual ~gp_mm()
-  {
-    gp_t* ptr;
-
-    while (free_list)
-    {
-      ptr = free_list->trans;
-
-      // Delete generic payload and all extensions
-      assert(ptr);
-      delete ptr;
-
-      free_list = free_list->next;
-    }
-
-    while (empties)
-    {
-      access* x = empties;
-      empties = empties->next;
-
-      // Delete free list access struct
-      delete x;
-    }
-  }
+  // The pool deletes every generic payload and its extensions
+  virtual ~gp_mm() { MM_ACCOUNT( on_destroy(this) ); }
 
   gp_t* allocate();
   void free(gp_t* trans);
 
+  // Data storage owned by a payload from this gp_mm and recycled with it, see slab_pool.h
+  unsigned char* data(gp_t* trans, unsigned int length) { return pool.data(trans, length); }
+
 private:
-  struct access
-  {
-    gp_t* trans;
-    access* next;
-    access* prev;
-  };
-
-  access* free_list;
-  access* empties;
+  Slab_pool pool;
 };
 
 
 gp_mm::gp_t* gp_mm::allocate()
 {
-  gp_t* ptr;
-  if (free_list)
-  {
-    ptr = free_list->trans;
-    empties = free_list;
-    free_list = free_list->next;
-  }
-  else
-  {
-    ptr = new gp_t(this);
-  }
+  gp_t* ptr = pool.get();
+  MM_ACCOUNT( on_allocate(this, ptr) );
   return ptr;
 }
 
 void gp_mm::free(gp_t* trans)
 {
+  MM_ACCOUNT( on_free(this, trans) );
   trans->reset(); // Delete auto extensions
-  if (!empties)
-  {
-    empties = new access;
-    empties->next = free_list;
-    empties->prev = 0;
-    if (free_list)
-      free_list->prev = empties;
-  }
-  free_list = empties;
-  free_list->trans = trans;
-  empties = free_list->prev;
+  pool.put(trans);
 }
 
 #endif
@@ -18,6 +18,8 @@
 //----------------------------------------------------------------------
 
 // Version 1  09-Sep-2008
+// Version 2  16-Oct-2026  Burst and byte-enable transfers
+// Version 3  16-Oct-2026  Transactions recorded in the transaction log
 
 
 #ifndef __LOCK_LT_TARGET_H__
@@ -45,32 +47,19 @@ struct Lock_LT_target: sc_module
   {
     tlm::tlm_command cmd = trans.get_command();
     sc_dt::uint64    adr = trans.get_address();
-    unsigned char*   ptr = trans.get_data_ptr();
-    unsigned int     len = trans.get_data_length();
-    unsigned char*   byt = trans.get_byte_enable_ptr();
-    unsigned int     wid = trans.get_streaming_width();
 
-    if (byt != 0) {
-      trans.set_response_status( tlm::TLM_BYTE_ENABLE_ERROR_RESPONSE );
+    if ( !check_burst(trans) )
       return;
-    }
-
-    if (len > 4 || wid < len) {
-      trans.set_response_status( tlm::TLM_BURST_ERROR_RESPONSE );
-      return;
-    }
 
     if ( cmd == tlm::TLM_READ_COMMAND )
     {
-      *reinterpret_cast<int*>(ptr) = -int(adr);
-      fout << hex << adr << " Execute READ, data = " << *reinterpret_cast<int*>(ptr)
-           << " in " << name() << endl;
+      execute_read( trans );
+      trans_log.record( this, Transaction_record::EXECUTE, cmd, adr, first_word(trans) );
     }
     else if ( cmd == tlm::TLM_WRITE_COMMAND )
-      fout << hex << adr << " Execute WRITE, data = " << *reinterpret_cast<int*>(ptr)
-           << " in " << name() << endl;
+      trans_log.record( this, Transaction_record::EXECUTE, cmd, adr, first_word(trans) );
 
-    delay = delay + LATENCY;
+    delay = delay + LATENCY + burst_latency(trans);
 
     trans.set_response_status( tlm::TLM_OK_RESPONSE );
   }
@@ -0,0 +1,163 @@
+
+// Filename: lock_table.h
+
+//----------------------------------------------------------------------
+//  Licensed under the Apache License, Version 2.0 (the "License");
+//  you may not use this file except in compliance with the License.
+//  You may obtain a copy of the License at
+//
+//  http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+//----------------------------------------------------------------------
+
+// Version 1  16-Oct-2026
+
+
+// *******************************************************************
+// Hash table of the locked addresses and their owners
+// *******************************************************************
+
+/*
+Lock_table holds only the addresses that are currently locked, each with the id of the
+initiator that locked it, in one open-addressing hash table with linear probing. unlock()
+removes the entry, shifting later entries of the same probe sequence back into the hole,
+so the table needs no tombstones and its size follows the number of locks held rather than
+the number of addresses ever accessed.
+
+Most transactions are ordinary reads and writes while no lock is held, so owner() and
+locked() test for an empty table before hashing anything.
+
+The table doubles when it becomes half full, and never shrinks.
+*/
+
+#ifndef __LOCK_TABLE_H__
+#define __LOCK_TABLE_H__
+
+#include "systemc"
+
+#include <vector>
+
+class Lock_table
+{
+public:
+  Lock_table( unsigned int capacity = 64 ) : m_size(0)
+  {
+    unsigned int n = 8;
+    while (n < capacity)
+      n <<= 1;
+    resize(n);
+  }
+
+  // The id of the initiator holding the lock on adr, or 0 if adr is not locked
+  const int* owner( sc_dt::uint64 adr ) const
+  {
+    if (m_size == 0)
+      return 0;
+    for (unsigned int i = slot(adr); m_entries[i].used; i = (i + 1) & m_mask)
+      if (m_entries[i].address == adr)
+        return &m_entries[i].id;
+    return 0;
+  }
+
+  bool locked( sc_dt::uint64 adr ) const { return owner(adr) != 0; }
+
+  // Locks adr for initiator id, or changes the owner if adr is already locked
+  void lock( sc_dt::uint64 adr, int id )
+  {
+    if (2 * (m_size + 1) > m_entries.size())
+      resize( 2 * m_entries.size() );
+
+    unsigned int i = slot(adr);
+    for (; m_entries[i].used; i = (i + 1) & m_mask)
+      if (m_entries[i].address == adr)
+      {
+        m_entries[i].id = id;
+        return;
+      }
+    m_entries[i].address = adr;
+    m_entries[i].id      = id;
+    m_entries[i].used    = true;
+    m_size++;
+  }
+
+  void unlock( sc_dt::uint64 adr )
+  {
+    if (m_size == 0)
+      return;
+
+    unsigned int i = slot(adr);
+    for (; m_entries[i].address != adr || !m_entries[i].used; i = (i + 1) & m_mask)
+      if (!m_entries[i].used)
+        return;
+
+    // Move back any later entry whose home slot does not lie in the cyclic range (i, j]
+    unsigned int j = i;
+    for (;;)
+    {
+      j = (j + 1) & m_mask;
+      if (!m_entries[j].used)
+        break;
+      unsigned int home = slot(m_entries[j].address);
+      if (((j - home) & m_mask) >= ((j - i) & m_mask))
+      {
+        m_entries[i] = m_entries[j];
+        i = j;
+      }
+    }
+    m_entries[i].used = false;
+    m_size--;
+  }
+
+  bool         empty() const { return m_size == 0; }
+  unsigned int size()  const { return m_size; }
+
+  // Number of slots, for measuring the memory used
+  unsigned int capacity() const { return (unsigned int)m_entries.size(); }
+
+private:
+  struct Entry
+  {
+    Entry() : address(0), id(0), used(false) {}
+
+    sc_dt::uint64 address;
+    int           id;
+    bool          used;
+  };
+
+  // Fibonacci hashing: the top bits of the product mix all the bits of the address
+  unsigned int slot( sc_dt::uint64 adr ) const
+  {
+    return (unsigned int)( (adr * 0x9E3779B97F4A7C15ULL) >> m_shift );
+  }
+
+  void resize( unsigned int n )
+  {
+    std::vector<Entry> old;
+    old.swap(m_entries);
+    m_entries.resize(n);
+    m_mask  = n - 1;
+    m_shift = 64;
+    while (n > 1)
+    {
+      n >>= 1;
+      m_shift--;
+    }
+
+    m_size = 0;
+    for (unsigned int i = 0; i < old.size(); i++)
+      if (old[i].used)
+        lock( old[i].address, old[i].id );
+  }
+
+  std::vector<Entry> m_entries;
+  unsigned int       m_mask;
+  unsigned int       m_shift;
+  unsigned int       m_size;
+};
+
+#endif
@@ -0,0 +1,223 @@
+
+// Filename: mm_accounting.h
+
+//----------------------------------------------------------------------
+//  Licensed under the Apache License, Version 2.0 (the "License");
+//  you may not use this file except in compliance with the License.
+//  You may obtain a copy of the License at
+//
+//  http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+//----------------------------------------------------------------------
+
+// Version 1  16-Oct-2026
+
+
+// *******************************************************************
+// Optional accounting of the payloads handed out by the memory managers
+// *******************************************************************
+
+/*
+Compile with -DMM_ACCOUNTING to enable. Otherwise every MM_ACCOUNT(...) hook expands to
+nothing and the memory managers are unchanged.
+
+For each memory manager, counts allocations, split into payloads served from the free list
+and payloads allocated for the first time, frees, live payloads and their high-water mark.
+For each module that allocates payloads, counts allocations and frees; a payload that is
+allocated but never freed means the acquire and release calls on it did not balance.
+
+Interconnects note every phase passing through them with MM_ACCOUNT(note_phase(...)), so
+that a payload still referenced at the end can be reported with its last phase.
+
+report() writes the summary, and is called from the destructor at exit if it has not been
+called before. The accounting is not thread-safe and does not cover mt_mm.
+*/
+
+#ifndef __MM_ACCOUNTING_H__
+#define __MM_ACCOUNTING_H__
+
+#ifdef MM_ACCOUNTING
+
+#include "tlm.h"
+
+#include <map>
+#include <string>
+#include <iostream>
+
+#define MM_ACCOUNT(call) Mm_accounting::instance().call
+
+class Mm_accounting
+{
+  typedef tlm::tlm_generic_payload gp_t;
+
+public:
+  static Mm_accounting& instance()
+  {
+    static Mm_accounting accounting;
+    return accounting;
+  }
+
+  ~Mm_accounting()
+  {
+    if (!m_reported)
+      report( std::cout );
+  }
+
+  void on_allocate( const tlm::tlm_mm_interface* mm, gp_t* trans )
+  {
+    Pool& p = pools[mm];
+    p.allocations++;
+
+    std::map<const gp_t*, Payload>::iterator it = payloads.find(trans);
+    if (it == payloads.end())
+    {
+      p.fresh++;
+      it = payloads.insert( std::make_pair(trans, Payload()) ).first;
+    }
+    else
+      p.from_free_list++;
+
+    if (++p.live > p.high_water)
+      p.high_water = p.live;
+
+    Payload& pl = it->second;
+    pl.mm     = mm;
+    pl.owner  = current_module();
+    pl.phase  = tlm::UNINITIALIZED_PHASE;
+    pl.when   = sc_core::sc_time_stamp();
+    pl.live   = true;
+    modules[pl.owner].allocated++;
+  }
+
+  void on_free( const tlm::tlm_mm_interface* mm, gp_t* trans )
+  {
+    Pool& p = pools[mm];
+    p.frees++;
+    p.live--;
+
+    Payload& pl = payloads[trans];
+    pl.live = false;
+    modules[pl.owner].freed++;
+  }
+
+  // The payloads of a memory manager are deleted with it
+  void on_destroy( const tlm::tlm_mm_interface* mm )
+  {
+    pools[mm].destroyed = true;
+  }
+
+  void note_phase( const gp_t& trans, const tlm::tlm_phase& phase )
+  {
+    std::map<const gp_t*, Payload>::iterator it = payloads.find(&trans);
+    if (it == payloads.end())
+      return;
+    it->second.phase = phase;
+    it->second.when  = sc_core::sc_time_stamp();
+  }
+
+  void report( std::ostream& os, unsigned int max_payloads = 20 )
+  {
+    m_reported = true;
+
+    os << "Memory manager accounting\n";
+    for (std::map<const tlm::tlm_mm_interface*, Pool>::iterator it = pools.begin();
+         it != pools.end(); ++it)
+    {
+      const Pool& p = it->second;
+      os << "  pool " << it->first
+         << ": allocations " << p.allocations
+         << " (free list " << p.from_free_list << ", fresh " << p.fresh << ")"
+         << ", frees " << p.frees
+         << ", live " << p.live
+         << ", high water " << p.high_water << "\n";
+    }
+
+    for (std::map<std::string, Module>::iterator it = modules.begin(); it != modules.end(); ++it)
+    {
+      const Module& m = it->second;
+      os << "  " << it->first << ": allocated " << m.allocated << ", freed " << m.freed;
+      if (m.allocated != m.freed)
+        os << "  IMBALANCE: " << (m.allocated - m.freed) << " payloads never released";
+      os << "\n";
+    }
+
+    unsigned int n = 0;
+    for (std::map<const gp_t*, Payload>::iterator it = payloads.begin(); it != payloads.end(); ++it)
+    {
+      const Payload& pl = it->second;
+      if (!pl.live)
+        continue;
+      if (n++ >= max_payloads)
+        continue;
+
+      os << "  still referenced: payload " << it->first << " allocated by " << pl.owner;
+      if (!pools[pl.mm].destroyed)
+        os << ", ref count " << it->first->get_ref_count();
+      os << ", last phase " << pl.phase << " at " << pl.when << "\n";
+    }
+    if (n > max_payloads)
+      os << "  ... and " << (n - max_payloads) << " more\n";
+  }
+
+private:
+  Mm_accounting() : m_reported(false) {}
+
+  static std::string current_module()
+  {
+    sc_core::sc_process_handle h = sc_core::sc_get_current_process_handle();
+    if (h.valid() && h.get_parent_object())
+      return h.get_parent_object()->name();
+    return "(elaboration)";
+  }
+
+  struct Pool
+  {
+    Pool() : allocations(0), from_free_list(0), fresh(0), frees(0), live(0), high_water(0),
+             destroyed(false) {}
+
+    sc_dt::uint64 allocations;
+    sc_dt::uint64 from_free_list;
+    sc_dt::uint64 fresh;
+    sc_dt::uint64 frees;
+    sc_dt::uint64 live;
+    sc_dt::uint64 high_water;
+    bool          destroyed;
+  };
+
+  struct Module
+  {
+    Module() : allocated(0), freed(0) {}
+
+    sc_dt::uint64 allocated;
+    sc_dt::uint64 freed;
+  };
+
+  struct Payload
+  {
+    Payload() : mm(0), live(false) {}
+
+    const tlm::tlm_mm_interface* mm;
+    std::string      owner;
+    tlm::tlm_phase   phase;
+    sc_core::sc_time when;
+    bool             live;
+  };
+
+  std::map<const tlm::tlm_mm_interface*, Pool> pools;
+  std::map<std::string, Module>                modules;
+  std::map<const gp_t*, Payload>               payloads;
+  bool m_reported;
+};
+
+#else
+
+#define MM_ACCOUNT(call)
+
+#endif
+
+#endif
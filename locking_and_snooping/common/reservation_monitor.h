@@ -0,0 +1,174 @@
+
+// Filename: reservation_monitor.h
+
+//----------------------------------------------------------------------
+//  Licensed under the Apache License, Version 2.0 (the "License");
+//  you may not use this file except in compliance with the License.
+//  You may obtain a copy of the License at
+//
+//  http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+//----------------------------------------------------------------------
+
+// Version 1  16-Oct-2026
+
+
+// *******************************************************************
+// LOAD-LINK/STORE-CONDITIONAL reservations, one per initiator
+// *******************************************************************
+
+/*
+Reservation_monitor holds at most one reservation for each initiator id, on one granule of
+memory: an aligned block whose size is a power of two, such as a 64-byte cache line. A
+LOAD-LINK replaces the reservation of its initiator. A STORE-CONDITIONAL succeeds only if
+its initiator still holds a reservation on the granule, and clears that reservation either
+way. Any write to a granule, including a successful STORE-CONDITIONAL, clears the
+reservations of every initiator on it.
+
+The reservations are a flat array indexed by id. So that a write need not look at every
+reservation, each granule also hashes to a bucket holding a bit mask of the ids whose
+reservation lies in a granule of that bucket. A write therefore reads one bucket, usually
+empty, and compares only the ids flagged there, whatever the number of addresses seen.
+Ids run from 0 to 63.
+*/
+
+#ifndef __RESERVATION_MONITOR_H__
+#define __RESERVATION_MONITOR_H__
+
+#include "systemc"
+
+#include <vector>
+#include <sstream>
+
+class Reservation_monitor
+{
+public:
+  static const unsigned int max_ids = 64;
+
+  Reservation_monitor( unsigned int granule = 4 )
+  : m_reservation(max_ids, none())
+  , m_bucket(4 * max_ids, 0)
+  , m_mask(4 * max_ids - 1)
+  , m_linked(0)
+  {
+    set_granule(granule);
+  }
+
+  // Bytes per granule, a power of two. Clears all reservations
+  void set_granule( unsigned int bytes )
+  {
+    if (bytes == 0 || (bytes & (bytes - 1)) != 0)
+      SC_REPORT_FATAL("Reservation_monitor", "The granule must be a power of two bytes");
+
+    m_shift = 0;
+    while ((1u << m_shift) < bytes)
+      m_shift++;
+    clear();
+  }
+
+  unsigned int granule() const { return 1u << m_shift; }
+
+  void load_link( int id, sc_dt::uint64 adr )
+  {
+    check_id(id);
+    drop(id);
+
+    sc_dt::uint64 g = adr >> m_shift;
+    m_reservation[id] = g;
+    m_bucket[bucket(g)] |= bit(id);
+    m_linked++;
+  }
+
+  // True if the store may go ahead. The store then clears the reservations on its granules
+  bool store_conditional( int id, sc_dt::uint64 adr, unsigned int len )
+  {
+    check_id(id);
+    bool ok = m_reservation[id] == (adr >> m_shift);
+    drop(id);
+    if (ok)
+      write(adr, len);
+    return ok;
+  }
+
+  // Clears the reservations on every granule touched by len bytes at adr
+  void write( sc_dt::uint64 adr, unsigned int len )
+  {
+    if (m_linked == 0)
+      return;
+
+    sc_dt::uint64 last = (adr + (len ? len - 1 : 0)) >> m_shift;
+    for (sc_dt::uint64 g = adr >> m_shift; g <= last; g++)
+    {
+      sc_dt::uint64 ids = m_bucket[bucket(g)];
+      while (ids)
+      {
+        unsigned int id = lowest(ids);
+        ids &= ids - 1;
+        if (m_reservation[id] == g)
+          drop(id);
+      }
+    }
+  }
+
+  bool linked( int id ) const { return m_reservation[id] != none(); }
+
+  void clear()
+  {
+    m_reservation.assign(max_ids, none());
+    m_bucket.assign(m_bucket.size(), 0);
+    m_linked = 0;
+  }
+
+private:
+  static sc_dt::uint64 none() { return ~sc_dt::uint64(0); }
+
+  void check_id( int id ) const
+  {
+    if (id < 0 || id >= int(max_ids))
+    {
+      std::ostringstream txt;
+      txt << "Initiator id " << id << " is outside the range 0 to " << max_ids - 1;
+      SC_REPORT_FATAL("Reservation_monitor", txt.str().c_str());
+    }
+  }
+
+  void drop( int id )
+  {
+    if (m_reservation[id] == none())
+      return;
+    m_bucket[bucket(m_reservation[id])] &= ~bit(id);
+    m_reservation[id] = none();
+    m_linked--;
+  }
+
+  unsigned int bucket( sc_dt::uint64 g ) const
+  {
+    return (unsigned int)( (g * 0x9E3779B97F4A7C15ULL) >> 32 ) & m_mask;
+  }
+
+  static sc_dt::uint64 bit( int id ) { return sc_dt::uint64(1) << id; }
+
+  static unsigned int lowest( sc_dt::uint64 ids )
+  {
+    unsigned int n = 0;
+    while (!(ids & 1))
+    {
+      ids >>= 1;
+      n++;
+    }
+    return n;
+  }
+
+  std::vector<sc_dt::uint64> m_reservation;   // Granule reserved by each id, or none()
+  std::vector<sc_dt::uint64> m_bucket;        // Ids with a reservation hashing to each bucket
+  unsigned int               m_mask;
+  unsigned int               m_shift;
+  unsigned int               m_linked;        // Number of reservations held
+};
+
+#endif
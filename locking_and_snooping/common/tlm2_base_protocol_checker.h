@@ -24,6 +24,8 @@
 // Version 3, 17 July 2008  Support compilation under SystemC 2.1.v1
 // Version 4, 12 Aug  2008  Add header #include <map>
 // Version 5, 08 Sep  2008  Fix bugs in message text
+// Version 6, 16 Oct  2026  Constant-time transaction state lookup, checking unlimited by default
+// Version 7, 16 Oct  2026  Sampled checking and pass-through mode
 
 // TLM-2.0 Base Protocol Compliance Checker
 
@@ -56,8 +58,10 @@ might become
 
 GENERAL FEATURES OF THE BASE PROTOCOL CHECKER
 
-The checks are relatively expensive, hence by default the number of checks is limited.
-A maximum number can be set explicitly by calling set_num_checks(max)
+By default every transaction is checked for the whole simulation. The state of each
+transaction is kept in an open-addressing hash table keyed by the transaction pointer, so the
+cost of a check does not grow with the number of transactions seen
+A maximum number of checks can be set explicitly by calling set_num_checks(max)
 Checking can be deactivated at any time by calling set_num_checks(0)
 All checkers decrement a single global count, because having some checkers running and
 others not can cause bogus violation reports
@@ -66,10 +70,29 @@ deactivated, because this could cause bogus violation reports
 
 The DMI and debug checks are unaffected by the num_checks count (because they are cheap)
 
+SAMPLING AND PASS-THROUGH
+
+set_sample_period(n) checks one transaction lifetime in every n, from BEGIN_REQ (or the call
+to b_transport) to the end of the response, on every checker along its path
+add_check_window(start, end) restricts checking to lifetimes that begin in [start, end)
+Any number of windows may be added. With windows and a sample period, one lifetime in n
+of those beginning inside the windows is checked
+The choice is made by the first checker on the path, so it is deterministic, and the
+other checkers follow it. Lifetimes that are not checked are not seen by the exclusion
+rule checks either, which therefore only compare checked transactions with one another
+
+The second template parameter CHECKS = false turns the checker into a pass-through: every
+call is forwarded unchanged and no state is kept, so the checker can stay in the netlist
+of a performance run at the cost of one extra function call per hop:
+
+  tlm_utils::tlm2_base_protocol_checker<32, false> *checker1;
+
 The error messages contain User Manual references
 
 The checker is designed to be used with a transaction pool: otherwise it could consume
-a lot of memory. The checker keeps a local copy of each transaction object
+a lot of memory. The checker keeps a local copy of each transaction object, and reuses
+the copy and its buffers when the transaction object is reused
+Compile with -DTLM2_CHECKER_STD_MAP to keep the state in std::map, as versions up to 5 did
 Failures are reported with a severity of SC_ERROR. The actions may be overridden by calling:
    sc_report_handler::set_actions("tlm2_protocol_checker", ...);
 
@@ -118,37 +141,136 @@ using std::hex;
 #include "tlm.h"
 #include <sstream>
 #include <map>
+#include <vector>
+#include <cstddef>
+#include <utility>
 
 
 namespace tlm_utils {
 
 
-// Number of checks remaining
-const  sc_dt::uint64 default_num_checks = 100000;
+// Number of checks remaining. The default is no limit
+const  sc_dt::uint64 default_num_checks = ~sc_dt::uint64(0);
 static sc_dt::uint64 num_checks = default_num_checks;
 
+// Sampling of transaction lifetimes. A period of 1 and no windows checks every lifetime
+static sc_dt::uint64 sample_period = 1;
+static sc_dt::uint64 sample_count  = 0;
+static std::vector< std::pair<sc_core::sc_time, sc_core::sc_time> > check_windows;
+
 
 // Types used when building a trace of the transaction path
 typedef unsigned char uchar_t;
 typedef std::deque<sc_core::sc_module*> deque_t;
 
 struct path_t {
-  path_t () { response_in_progress = false; ok_response = false; resp_data_ptr = 0; }
+  path_t () { response_in_progress = false; ok_response = false; resp_data_ptr = 0;
+              resp_data_size = 0; resp_data_valid = false;
+              lifetime_open = false; sampled = true; decider = 0; }
+
+  bool          response_in_progress;
+  bool          ok_response;
+  deque_t       path;
+  uchar_t*      resp_data_ptr;    // Copy of data on response path
+  unsigned int  resp_data_size;   // Size of the buffer at resp_data_ptr
+  bool          resp_data_valid;  // Copy taken for the current response
+
+  // Sampling decision for the current lifetime, made by the first checker on the path
+  bool                  lifetime_open;
+  bool                  sampled;
+  sc_core::sc_module*   decider;
+};
+
+
+// Map from transaction pointer to state, with open addressing and linear probing
+// Entries are never removed: a pooled transaction object finds its previous entry again
+// The last key looked up is remembered, since each check looks up the same transaction
+// many times in a row
+template <typename T>
+class trans_map
+{
+public:
+  trans_map() : m_size(0), m_last_key(0), m_last(0), m_keys(64, (const void*)0), m_values(64) {}
+
+  T& operator[] (const void* key)
+  {
+    if (key == m_last_key)
+      return m_values[m_last];
+
+    std::size_t mask = m_keys.size() - 1;
+    std::size_t i = hash(key) & mask;
+    while (m_keys[i] != key)
+    {
+      if (m_keys[i] == 0)
+      {
+        if (2 * (m_size + 1) > m_keys.size())
+        {
+          grow();
+          return (*this)[key];
+        }
+        m_keys[i] = key;
+        m_size++;
+        break;
+      }
+      i = (i + 1) & mask;
+    }
+    m_last_key = key;
+    m_last = i;
+    return m_values[i];
+  }
+
+  std::size_t size() const { return m_size; }
+
+private:
+  static std::size_t hash(const void* key)
+  {
+    // Fibonacci hashing, after dropping the low bits that are zero due to alignment
+    sc_dt::uint64 h = (sc_dt::uint64)reinterpret_cast<std::size_t>(key) >> 4;
+    h *= 0x9E3779B97F4A7C15ULL;
+    return (std::size_t)(h ^ (h >> 32));
+  }
 
-  bool      response_in_progress;
-  bool      ok_response;
-  deque_t   path;
-  uchar_t*  resp_data_ptr;  // Copy of data on response path
+  void grow()
+  {
+    std::vector<const void*> keys( 2 * m_keys.size(), (const void*)0 );
+    std::vector<T>           values( 2 * m_keys.size() );
+    std::size_t mask = keys.size() - 1;
+
+    for (std::size_t j = 0; j < m_keys.size(); j++)
+      if (m_keys[j])
+      {
+        std::size_t i = hash(m_keys[j]) & mask;
+        while (keys[i])
+          i = (i + 1) & mask;
+        keys[i] = m_keys[j];
+        std::swap( values[i], m_values[j] );
+      }
+
+    m_keys.swap(keys);
+    m_values.swap(values);
+    m_last_key = 0;
+  }
+
+  std::size_t              m_size;
+  const void*              m_last_key;
+  std::size_t              m_last;
+  std::vector<const void*> m_keys;
+  std::vector<T>           m_values;
 };
 
+
 // Global variable used for checks involving multiple checkers along a transaction path
+#ifdef TLM2_CHECKER_STD_MAP
 static std::map<tlm::tlm_generic_payload*, path_t> shared_map;
+#else
+static trans_map<path_t> shared_map;
+#endif
 
 
 // ******************** CLASS DEFINITION ********************
 
 
-template <unsigned int  BUSWIDTH = 32>
+template <unsigned int  BUSWIDTH = 32, bool CHECKS = true>
 class tlm2_base_protocol_checker
 
 : public sc_core::sc_module
@@ -181,55 +303,94 @@ public:
   static sc_dt::uint64 get_num_checks() { return num_checks; }
 
 
+  // Access methods for sampling
+
+  static void set_sample_period(sc_dt::uint64 n) {
+    if (n == 0)
+      SC_REPORT_FATAL("tlm2_protocol_checker", "Sample period must be at least 1");
+    sample_period = n;
+  }
+
+  static sc_dt::uint64 get_sample_period() { return sample_period; }
+
+  static void add_check_window(const sc_core::sc_time& start, const sc_core::sc_time& end) {
+    check_windows.push_back( std::make_pair(start, end) );
+  }
+
+
   // TLM-2.0 interface methods for initiator and target sockets, instrumented with checks
 
   virtual tlm::tlm_sync_enum nb_transport_fw(
     tlm::tlm_generic_payload& trans, tlm::tlm_phase& phase, sc_core::sc_time& delay)
   {
+    if (!CHECKS)
+      return initiator_socket->nb_transport_fw( trans, phase, delay );
+
     tlm::tlm_phase& start_phase = phase;
+    bool end_resp = (phase == tlm::END_RESP);
+    bool check = num_checks && is_sampled( trans, phase == tlm::BEGIN_REQ );
 
-    if (num_checks)
+    if (check)
       nb_transport_fw_pre_checks( trans, phase, delay );
 
     tlm::tlm_sync_enum status;
     status = initiator_socket->nb_transport_fw( trans, phase, delay );
 
-    if (num_checks)
+    if (check && num_checks)
       nb_transport_fw_post_checks( trans, start_phase, phase, delay, status );
 
+    end_of_lifetime( trans, end_resp || status == tlm::TLM_COMPLETED );
     return status;
   }
 
   virtual tlm::tlm_sync_enum nb_transport_bw(
     tlm::tlm_generic_payload& trans, tlm::tlm_phase& phase, sc_core::sc_time& delay)
   {
-    if (num_checks)
+    if (!CHECKS)
+      return target_socket->nb_transport_bw( trans, phase, delay );
+
+    bool check = num_checks && is_sampled( trans, false );
+
+    if (check)
       nb_transport_bw_pre_checks( trans, phase, delay );
 
     tlm::tlm_sync_enum status;
     status = target_socket->nb_transport_bw( trans, phase, delay );
 
-    if (num_checks)
+    if (check && num_checks)
       nb_transport_bw_post_checks( trans, phase, delay, status );
 
+    end_of_lifetime( trans, status == tlm::TLM_COMPLETED
+                         || (status == tlm::TLM_UPDATED && phase == tlm::END_RESP) );
     return status;
   }
 
   virtual void b_transport( tlm::tlm_generic_payload& trans, sc_core::sc_time& delay )
   {
-    if (num_checks)
+    if (!CHECKS)
+    {
+      initiator_socket->b_transport( trans, delay );
+      return;
+    }
+
+    bool check = num_checks && is_sampled( trans, true );
+
+    if (check)
       b_transport_pre_checks( trans, delay );
 
     initiator_socket->b_transport( trans, delay );
 
-    if (num_checks)
+    if (check && num_checks)
       b_transport_post_checks( trans, delay );
+
+    end_of_lifetime( trans, true );
   }
 
   virtual bool get_direct_mem_ptr(tlm::tlm_generic_payload& trans,
                                   tlm::tlm_dmi&  dmi_data)
   {
-    get_direct_mem_ptr_pre_checks( trans, dmi_data );
+    if (CHECKS)
+      get_direct_mem_ptr_pre_checks( trans, dmi_data );
 
     bool status;
     status = initiator_socket->get_direct_mem_ptr( trans, dmi_data );
@@ -244,17 +405,22 @@ public:
 
   virtual unsigned int transport_dbg(tlm::tlm_generic_payload& trans)
   {
-    transport_dbg_pre_checks( trans );
+    if (CHECKS)
+      transport_dbg_pre_checks( trans );
 
     unsigned int count;
     count = initiator_socket->transport_dbg( trans );
 
-    transport_dbg_post_checks( trans, count );
+    if (CHECKS)
+      transport_dbg_post_checks( trans, count );
     return count;
   }
 
 
 private:
+  bool is_sampled( tlm::tlm_generic_payload& trans, bool begin );
+  void end_of_lifetime( tlm::tlm_generic_payload& trans, bool end );
+
   void b_transport_pre_checks( tlm::tlm_generic_payload& trans, sc_core::sc_time& delay);
 
   void b_transport_post_checks( tlm::tlm_generic_payload& trans, sc_core::sc_time& delay);
@@ -292,7 +458,8 @@ private:
 private:
 
   struct state_t {
-    state_t() { b_call = 0; ph = tlm::UNINITIALIZED_PHASE; gp = 0; }
+    state_t() { b_call = 0; ph = tlm::UNINITIALIZED_PHASE; gp = 0;
+                byte_enable_buffer = 0; data_size = 0; byte_enable_size = 0; }
 
     bool                      has_mm;
     unsigned int              b_call;    // Number of b_transport calls in progress
@@ -301,10 +468,17 @@ private:
     tlm::tlm_generic_payload* gp;        // Points to new data and byte enable buffers
     uchar_t*                  data_ptr;  // Stores original pointers
     uchar_t*                  byte_enable_ptr;
+    uchar_t*                  byte_enable_buffer;  // Byte enable buffer of gp, when used
+    unsigned int              data_size;           // Sizes of the buffers of gp
+    unsigned int              byte_enable_size;
   };
 
   // Transaction state for the specific hop where this checker is inlined
+#ifdef TLM2_CHECKER_STD_MAP
   std::map<tlm::tlm_generic_payload*, state_t> m_map;
+#else
+  trans_map<state_t> m_map;
+#endif
 
   // Flags for exclusion rules
   tlm::tlm_generic_payload* m_request_in_progress;
@@ -320,8 +494,46 @@ private:
 
 
 #define BOILERPLATE \
-template <unsigned int BUSWIDTH> \
-void tlm2_base_protocol_checker<BUSWIDTH>::
+template <unsigned int BUSWIDTH, bool CHECKS> \
+void tlm2_base_protocol_checker<BUSWIDTH, CHECKS>::
+
+
+// Returns true if the current lifetime of the transaction is to be checked. At the start
+// of a lifetime, the first checker on the path makes the choice for all the others
+template <unsigned int BUSWIDTH, bool CHECKS>
+bool tlm2_base_protocol_checker<BUSWIDTH, CHECKS>::
+is_sampled( tlm::tlm_generic_payload& trans, bool begin )
+{
+  if (sample_period == 1 && check_windows.empty())
+    return true;
+
+  path_t& p = shared_map[&trans];
+  if (begin && !p.lifetime_open)
+  {
+    bool in_window = check_windows.empty();
+    sc_core::sc_time now = sc_core::sc_time_stamp();
+    for (unsigned int i = 0; i < check_windows.size() && !in_window; i++)
+      in_window = now >= check_windows[i].first && now < check_windows[i].second;
+
+    p.lifetime_open = true;
+    p.decider = this;
+    p.sampled = in_window && (sample_count++ % sample_period == 0);
+  }
+  return p.sampled;
+}
+
+
+// The lifetime ends when the response has passed back through the first checker
+BOILERPLATE
+end_of_lifetime( tlm::tlm_generic_payload& trans, bool end )
+{
+  if (!end || (sample_period == 1 && check_windows.empty()))
+    return;
+
+  path_t& p = shared_map[&trans];
+  if (p.decider == this)
+    p.lifetime_open = false;
+}
 
 
 BOILERPLATE
@@ -617,7 +829,7 @@ BOILERPLATE
 check_initial_state(
     tlm::tlm_generic_payload& trans, const char* txt2 )
 {
-  if (num_checks > 0)
+  if (num_checks > 0 && num_checks != default_num_checks)
   {
     --num_checks;
     if (num_checks == 0)
@@ -662,37 +874,39 @@ check_initial_state(
     tlm2error(trans, "6.16 e)");
   }
 
-  // Setup clones of transaction and buffers in map
-  tlm::tlm_generic_payload* gp = m_map[&trans].gp;
+  // Setup clones of transaction and buffers in map. The buffers are kept for the next
+  // transaction that uses the same object, and only replaced when too small
+  state_t& state = m_map[&trans];
+  tlm::tlm_generic_payload* gp = state.gp;
   if (gp == 0)
     gp = new tlm::tlm_generic_payload;  // Memory leak: transactions are never cleared from map
   else
+    gp->free_all_extensions();
+
+  if (trans.get_data_length() > state.data_size)
   {
     delete [] gp->get_data_ptr();
-    gp->free_all_extensions();
+    state.data_size = trans.get_data_length();
+    gp->set_data_ptr( new uchar_t[state.data_size] );
   }
-  gp->set_data_ptr( new uchar_t[trans.get_data_length()] );
-  m_map[&trans].data_ptr = trans.get_data_ptr();
+  state.data_ptr = trans.get_data_ptr();
 
-  if (gp->get_byte_enable_ptr())
-    delete [] gp->get_byte_enable_ptr();
-  if (trans.get_byte_enable_ptr())
-    gp->set_byte_enable_ptr( new uchar_t[trans.get_byte_enable_length()] );
-  else
-    gp->set_byte_enable_ptr(0);
-  m_map[&trans].byte_enable_ptr = trans.get_byte_enable_ptr();
+  if (trans.get_byte_enable_ptr() && trans.get_byte_enable_length() > state.byte_enable_size)
+  {
+    delete [] state.byte_enable_buffer;
+    state.byte_enable_size = trans.get_byte_enable_length();
+    state.byte_enable_buffer = new uchar_t[state.byte_enable_size];
+  }
+  gp->set_byte_enable_ptr( trans.get_byte_enable_ptr() ? state.byte_enable_buffer : 0 );
+  state.byte_enable_ptr = trans.get_byte_enable_ptr();
 
   gp->deep_copy_from(trans);
-  m_map[&trans].gp = gp;
-  m_map[&trans].time = sc_core::SC_ZERO_TIME;
-  m_map[&trans].has_mm = trans.has_mm();
+  state.gp = gp;
+  state.time = sc_core::SC_ZERO_TIME;
+  state.has_mm = trans.has_mm();
 
   // Store request path checker sequence
-  if (shared_map[&trans].resp_data_ptr)
-  {
-    delete [] shared_map[&trans].resp_data_ptr;
-    shared_map[&trans].resp_data_ptr = 0;
-  }
+  shared_map[&trans].resp_data_valid = false;
   if (shared_map[&trans].response_in_progress)
   {
     txt << "Transaction object sent with BEGIN_REQ while still being used on a previous response path, detected in " << txt2;
@@ -769,7 +983,7 @@ check_trans_not_modified(
         }
   }
 
-  uchar_t* resp_data_ptr = shared_map[&trans].resp_data_ptr;
+  uchar_t* resp_data_ptr = shared_map[&trans].resp_data_valid ? shared_map[&trans].resp_data_ptr : 0;
   if (resp_data_ptr)
     for (unsigned int i = 0; i < trans.get_data_length(); i++)
       if (trans.get_data_ptr()[i] != resp_data_ptr[i])
@@ -801,10 +1015,16 @@ check_response_path(
     shared_map[&trans].ok_response = trans.is_response_ok();
 
     // Create a copy of the data array for comparison on the response path
-    if ( !shared_map[&trans].resp_data_ptr )
+    if ( !shared_map[&trans].resp_data_valid )
     {
-      shared_map[&trans].resp_data_ptr = new u_char[trans.get_data_length()];
+      if (trans.get_data_length() > shared_map[&trans].resp_data_size)
+      {
+        delete [] shared_map[&trans].resp_data_ptr;
+        shared_map[&trans].resp_data_size = trans.get_data_length();
+        shared_map[&trans].resp_data_ptr = new u_char[trans.get_data_length()];
+      }
       memcpy(shared_map[&trans].resp_data_ptr, trans.get_data_ptr(), trans.get_data_length());
+      shared_map[&trans].resp_data_valid = true;
     }
   }
 }
@@ -0,0 +1,222 @@
+
+// Filename: transaction_log.h
+
+//----------------------------------------------------------------------
+//  Licensed under the Apache License, Version 2.0 (the "License");
+//  you may not use this file except in compliance with the License.
+//  You may obtain a copy of the License at
+//
+//  http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+//----------------------------------------------------------------------
+
+// Version 1  16-Oct-2026
+// Version 2  16-Oct-2026  Record the phase, and the text of TLM-2.0-Example6
+
+
+// *******************************************************************
+// Log of the transactions issued, executed and checked by the example modules
+// *******************************************************************
+
+/*
+The initiators and targets record what they do through the Transaction_log declared in
+common_header.h (utilities.h in TLM-2.0-Example6), instead of writing a line of text to
+fout for every event.
+
+By default each event is written to the text stream as before, one line at a time. After
+open(filename), events are instead appended as 32-byte Transaction_records to a binary
+log drained to disk by a background thread (see binary_log.h), so the simulation thread
+neither formats nor flushes anything:
+
+  trans_log.open("example.bin");   // before sc_start
+  ...
+  trans_log.close();               // after the run
+
+close() also writes the names of the modules, one per line, to example.bin.modules, and
+tools/trans_decode turns the binary log back into exactly the text of the text path.
+
+The modules of at_example and of TLM-2.0-Example6 wrote their lines in different formats,
+so each log has a style, which selects the format of its text and is kept in the magic
+string of the binary log. The phase is only recorded for PHASE events, and is
+UNINITIALIZED_PHASE otherwise.
+*/
+
+#ifndef __TRANSACTION_LOG_H__
+#define __TRANSACTION_LOG_H__
+
+#include "systemc"
+#include "tlm.h"
+#include "../common/binary_log.h"
+
+#include <string>
+#include <vector>
+#include <map>
+#include <ostream>
+#include <fstream>
+
+struct Transaction_record
+{
+  enum event_t { NEW, CHECK, EXECUTE, ERROR, PHASE, B_TRANSPORT };
+  enum style_t { AT_EXAMPLE, EXAMPLE6 };
+
+  sc_dt::uint64  time;      // sc_time_stamp(), in units of the time resolution
+  sc_dt::uint64  address;   // The delay, in units of the time resolution, for B_TRANSPORT
+  unsigned int   data;      // First word of the data, or the response status for ERROR
+  unsigned short module;
+  unsigned char  event;
+  unsigned char  command;
+  unsigned char  phase;     // The tlm_phase received, for PHASE
+};
+
+
+class Transaction_log
+{
+public:
+  Transaction_log( std::ostream& text, Transaction_record::style_t style = Transaction_record::AT_EXAMPLE )
+  : m_text(text), m_style(style), m_last_module(0), m_last_id(0) {}
+
+  ~Transaction_log() { close(); }
+
+  // Switches from the text stream to a binary log
+  bool open( const std::string& filename )
+  {
+    m_filename = filename;
+    return m_log.open( filename.c_str(), magic(m_style) );
+  }
+
+  // The magic string of a binary log of this style
+  static const char* magic( Transaction_record::style_t style )
+  {
+    return style == Transaction_record::EXAMPLE6 ? "TRANSL6" : "TRANSLG";
+  }
+
+  void close()
+  {
+    if (!m_log.is_open())
+      return;
+    m_log.close();
+
+    std::ofstream modules( (m_filename + ".modules").c_str() );
+    for (unsigned int i = 0; i < m_names.size(); i++)
+      modules << m_names[i] << "\n";
+  }
+
+  bool is_open() const { return m_log.is_open(); }
+
+  void record( const sc_core::sc_object* module, Transaction_record::event_t event,
+               tlm::tlm_command cmd, sc_dt::uint64 address, unsigned int data,
+               const tlm::tlm_phase& phase = tlm::UNINITIALIZED_PHASE )
+  {
+    // Value-initialized, so that the padding written to the log is zero
+    Transaction_record r = Transaction_record();
+    r.time    = sc_core::sc_time_stamp().value();
+    r.address = address;
+    r.data    = data;
+    r.module  = module_id(module);
+    r.event   = event;
+    r.command = cmd;
+    r.phase   = (unsigned char)(unsigned int)phase;
+
+    if (m_log.is_open())
+      m_log.append(r);
+    else
+      format( m_text, r, m_names[r.module], m_style ) << std::flush;
+  }
+
+  // The text of one record, identical to the lines the modules used to write to fout
+  static std::ostream& format( std::ostream& os, const Transaction_record& r, const std::string& name,
+                               Transaction_record::style_t style = Transaction_record::AT_EXAMPLE )
+  {
+    if (style == Transaction_record::EXAMPLE6)
+      return format_example6( os, r, name );
+
+    const char* cmd = r.command ? "write" : "read";
+    switch (r.event) {
+    case Transaction_record::NEW:
+    case Transaction_record::CHECK:
+      os << std::hex << r.address << (r.event == Transaction_record::NEW ? " new" : " check")
+         << ", cmd=" << cmd << ", data=" << std::hex << r.data
+         << " at time " << sc_core::sc_time::from_value(r.time) << " in " << name << "\n";
+      break;
+
+    case Transaction_record::EXECUTE:
+      os << std::hex << r.address << " Execute " << (r.command ? "WRITE" : "READ")
+         << ", data = " << r.data << " in " << name << "\n";
+      break;
+
+    case Transaction_record::ERROR:
+      {
+        tlm::tlm_generic_payload trans;
+        trans.set_response_status( tlm::tlm_response_status( int(r.data) ) );
+        os << "Transaction returned with error, response status = "
+           << trans.get_response_string() << "\n... ";
+      }
+      break;
+    }
+    return os;
+  }
+
+  static std::ostream& format_example6( std::ostream& os, const Transaction_record& r, const std::string& name )
+  {
+    char cmd = r.command ? 'W' : 'R';
+    sc_core::sc_time time = sc_core::sc_time::from_value(r.time);
+    switch (r.event) {
+    case Transaction_record::NEW:
+    case Transaction_record::CHECK:
+      os << std::hex << r.address << " " << name << (r.event == Transaction_record::NEW ? " new" : " check")
+         << ", cmd=" << cmd << ", data=" << std::hex << r.data << " at time " << time << "\n";
+      break;
+
+    case Transaction_record::EXECUTE:
+      os << std::hex << r.address << " " << name << " Execute " << (r.command ? "WRITE" : "READ")
+         << ", target = " << name << " data = " << r.data << "\n";
+      break;
+
+    case Transaction_record::PHASE:
+      os << std::hex << r.address << " " << name << " " << tlm::tlm_phase( r.phase )
+         << " at " << time << "\n";
+      break;
+
+    case Transaction_record::B_TRANSPORT:
+      os << "Calling b_transport at " << time << " with delay = "
+         << sc_core::sc_time::from_value(r.address) << "\n";
+      break;
+    }
+    return os;
+  }
+
+  sc_dt::uint64 written() const { return m_log.written(); }
+
+private:
+  unsigned short module_id( const sc_core::sc_object* module )
+  {
+    if (module == m_last_module)
+      return m_last_id;
+
+    std::map<const sc_core::sc_object*, unsigned short>::iterator it = m_ids.find(module);
+    if (it == m_ids.end())
+    {
+      it = m_ids.insert( std::make_pair(module, (unsigned short)m_names.size()) ).first;
+      m_names.push_back( module->name() );
+    }
+    m_last_module = module;
+    m_last_id     = it->second;
+    return m_last_id;
+  }
+
+  std::ostream&                  m_text;
+  Transaction_record::style_t    m_style;
+  Binary_log<Transaction_record> m_log;
+  std::string                    m_filename;
+  std::vector<std::string>       m_names;
+  std::map<const sc_core::sc_object*, unsigned short> m_ids;
+  const sc_core::sc_object*      m_last_module;
+  unsigned short                 m_last_id;
+};
+
+#endif
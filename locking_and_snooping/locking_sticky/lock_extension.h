@@ -19,6 +19,7 @@
 
 // Version 1  09-Sep-2008
 // Version 2  02-Jul-2009
+// Version 3  16-Oct-2026  Initiator id in the LOAD-LINK/STORE-CONDITIONAL extension
 
 
 #ifndef __LOCK_EXTENSION_H__
@@ -118,18 +119,20 @@ struct load_link_extension: tlm::tlm_extension<load_link_extension>
 {
   // LOAD-LINK/STORE-CONDITIONAL command extension for atomic memory operations.
 
-  load_link_extension() { cmd = LOAD_LINK; valid = false; }
+  load_link_extension() { cmd = LOAD_LINK; id = 0; valid = false; }
 
   virtual tlm_extension_base* clone() const
   {
     load_link_extension* ext = new load_link_extension;
     ext->cmd = this->cmd;
+    ext->id  = this->id;
     return ext;
   }
 
   virtual void copy_from(tlm_extension_base const &ext)
   {
     cmd = static_cast<load_link_extension const &>(ext).cmd;
+    id  = static_cast<load_link_extension const &>(ext).id;
   }
 
   virtual void free()
@@ -139,6 +142,7 @@ struct load_link_extension: tlm::tlm_extension<load_link_extension>
 
   enum cmd_t {LOAD_LINK, STORE_CONDITIONAL};
   cmd_t cmd;
+  int   id;   // Initiator taking the link, which has one reservation of its own
   bool valid;
 };
 
@@ -19,6 +19,8 @@
 
 // Version 1  09-Sep-2008
 // Version 2  02-Jul-2009
+// Version 3  16-Oct-2026  Random numbers from a stream of its own
+// Version 4  16-Oct-2026  Initiator id carried by LOAD-LINK and STORE-CONDITIONAL
 
 
 #ifndef __LOCK_LT_INITIATOR_H__
@@ -33,8 +35,10 @@ struct Lock_LT_initiator: sc_module
 
   tlm_utils::simple_initiator_socket<Lock_LT_initiator, 32> socket;
 
-  Lock_LT_initiator(sc_module_name _n, gp_mm* mm)
+  Lock_LT_initiator(sc_module_name _n, gp_mm* mm, int id = 0)
   : socket("socket")
+  , m_id(id)
+  , m_random(name())
   {
     m_mm1 = new lock_mm;
     m_mm2 = new load_link_mm;
@@ -74,7 +78,7 @@ struct Lock_LT_initiator: sc_module
       if (next_read)
       {
         // Start a fresh read-modify-write command cycle
-        addr = 0x400 | ((rand() % 256) & 0xFC); // Assuming memory is 5th target (or 4, counting from 0)
+        addr = 0x400 | (m_random.below(256) & 0xFC); // Assuming memory is 5th target (or 4, counting from 0)
         next_read  = false;
         next_write = true;
       }
@@ -95,7 +99,7 @@ struct Lock_LT_initiator: sc_module
           // The read may fail if the address is already locked, forcing the read to be repeated
           // with the same address and data, only moving on to a fresh read-write cycle
           // when it succeeds.
-          store_data = (rand() << 16) | rand();
+          store_data = int(m_random.next());
           next_write = false;
         }
         data1 = store_data;
@@ -166,11 +170,13 @@ struct Lock_LT_initiator: sc_module
       if (next_load)
       {
         // Start a fresh LOAD-STORE command cycle
-        addr = 0x500 | ((rand() % 256) & 0xFC); // Assuming memory is 6th target (or 5, counting from 0)
+        addr = 0x500 | (m_random.below(256) & 0xFC); // Assuming memory is 6th target (or 5, counting from 0)
         next_load  = false;
         next_store = true;
       }
 
+      ext->id = m_id;
+
       if (i % 2 == 0)
       {
         cmd = tlm::TLM_READ_COMMAND;
@@ -187,7 +193,7 @@ struct Lock_LT_initiator: sc_module
           // The STORE_CONDITIONAL may fail, forcing the LOAD-STORE to be repeated
           // with the same address and data, only moving on to a fresh LOAD-STORE cycle
           // when it succeeds.
-          store_data = (rand() << 16) | rand();
+          store_data = int(m_random.next());
           next_store = false;
         }
         data2 = store_data;
@@ -237,6 +243,10 @@ struct Lock_LT_initiator: sc_module
 
   int data1;  // Internal data buffer used by initiator with generic payload
   int data2;  // Internal data buffer used by initiator with generic payload
+
+  int m_id;   // Initiator id for LOAD-LINK/STORE-CONDITIONAL
+
+  Random_stream m_random;
 };
 
 #endif
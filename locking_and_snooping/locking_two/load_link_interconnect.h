@@ -19,6 +19,7 @@
 
 // Version 1  09-Sep-2008
 // Version 2  02-Jul-2009
+// Version 3  16-Oct-2026  One reservation per initiator, at a configurable granule
 
 
 #ifndef __LOAD_LINK_INTERCONNECT_H__
@@ -26,6 +27,7 @@
 
 #include "../common/common_header.h"
 #include "lock_extension.h"
+#include "../common/reservation_monitor.h"
 
 struct Load_link_interconnect: sc_module
 {
@@ -46,6 +48,10 @@ struct Load_link_interconnect: sc_module
     init_socket.register_invalidate_direct_mem_ptr(this, &Load_link_interconnect::invalidate_direct_mem_ptr);
   }
 
+  // Size of the block of memory covered by one reservation, such as a 64-byte cache line.
+  // The default of 4 bytes is one word. Clears all reservations
+  void set_granule( unsigned int bytes ) { monitor.set_granule(bytes); }
+
   virtual void b_transport( tlm::tlm_generic_payload& trans, sc_time& delay )
   {
     if ( load_link_store_conditional( trans ) )
@@ -102,27 +108,26 @@ struct Load_link_interconnect: sc_module
 
       if (ext->cmd == load_link_data_ext::LOAD_LINK)
       {
-        lock_map[adr] = true;
+        monitor.load_link( ext->id, adr );
       }
       else if (ext->cmd == load_link_data_ext::STORE_CONDITIONAL)
       {
-        if ( !lock_map[adr] )
+        if ( !monitor.store_conditional( ext->id, adr, trans.get_data_length() ) )
         {
           trans.set_response_status( tlm::TLM_COMMAND_ERROR_RESPONSE );
           return false;
         }
-        lock_map[adr] = false;
       }
     }
     else if (cmd == tlm::TLM_WRITE_COMMAND)
     {
-      if (lock_map[adr])
-        lock_map[adr] = false;
+      monitor.write( adr, trans.get_data_length() );
     }
     return true;
   }
 
-  std::map <sc_dt::uint64, bool> lock_map;
+  // One reservation per initiator id
+  Reservation_monitor monitor;
 };
 
 #endif
@@ -19,6 +19,7 @@
 
 // Version 1  09-Sep-2008
 // Version 2  02-Jul-2009
+// Version 3  16-Oct-2026  Initiator id in the LOAD-LINK/STORE-CONDITIONAL extension
 
 
 #ifndef __LOCK_EXTENSION_H__
@@ -49,22 +50,25 @@ struct load_link_guard_ext: tlm::tlm_extension<load_link_guard_ext>
 
 struct load_link_data_ext: tlm::tlm_extension<load_link_data_ext>
 {
-  load_link_data_ext() { cmd = LOAD_LINK; }
+  load_link_data_ext() { cmd = LOAD_LINK; id = 0; }
 
   virtual tlm_extension_base* clone() const
   {
     load_link_data_ext* ext = new load_link_data_ext;
     ext->cmd = this->cmd;
+    ext->id  = this->id;
     return ext;
   }
 
   virtual void copy_from(tlm_extension_base const &ext)
   {
     cmd = static_cast<load_link_data_ext const &>(ext).cmd;
+    id  = static_cast<load_link_data_ext const &>(ext).id;
   }
 
   enum cmd_t {LOAD_LINK, STORE_CONDITIONAL};
   cmd_t cmd;
+  int   id;   // Initiator taking the link, which has one reservation of its own
 };
 
 
@@ -19,6 +19,7 @@
 
 // Version 1  09-Sep-2008
 // Version 2  02-Jul-2009
+// Version 3  16-Oct-2026  Locks held in a hash table of locked addresses only
 
 
 #ifndef __LOCK_INTERCONNECT_H__
@@ -26,6 +27,7 @@
 
 #include "../common/common_header.h"
 #include "lock_extension.h"
+#include "../common/lock_table.h"
 
 struct Lock_interconnect: sc_module
 {
@@ -101,22 +103,20 @@ struct Lock_interconnect: sc_module
 
       if (ext->lock)
       {
-        if ( lock_map[adr] )
+        if ( lock_table.locked(adr) )
         {
           trans.set_response_status( tlm::TLM_COMMAND_ERROR_RESPONSE );
           return true;
         }
         else
-        {
-          lock_map[adr] = true;
-          lock_id[adr] = ext->id;
-        }
+          lock_table.lock( adr, ext->id );
       }
       else // lock == false
       {
-        if ( lock_map[adr] )
-          if ( lock_id[adr] == 0 || lock_id[adr] == ext->id )
-            lock_map[adr] = false;
+        const int* owner = lock_table.owner(adr);
+        if ( owner )
+          if ( *owner == 0 || *owner == ext->id )
+            lock_table.unlock( adr );
           else
           {
             trans.set_response_status( tlm::TLM_COMMAND_ERROR_RESPONSE );
@@ -126,7 +126,7 @@ struct Lock_interconnect: sc_module
     }
     else // Extension absent
     {
-      if (lock_map[adr])
+      if (lock_table.locked(adr))
       {
         trans.set_response_status( tlm::TLM_COMMAND_ERROR_RESPONSE );
         return true;
@@ -135,8 +135,8 @@ struct Lock_interconnect: sc_module
     return false;
   }
 
-  std::map <sc_dt::uint64, bool> lock_map;
-  std::map <sc_dt::uint64, int>  lock_id;
+  // Only the addresses currently locked, with the id of the initiator holding each lock
+  Lock_table lock_table;
 };
 
 #endif
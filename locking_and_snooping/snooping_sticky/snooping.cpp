@@ -18,6 +18,7 @@
 //----------------------------------------------------------------------
 
 // Version 1  03-Jul-2009
+// Version 2  16-Oct-2026  Random numbers from a stream per module
 
 /*
 
@@ -66,6 +67,7 @@ using namespace std;
 #include "tlm_utils/tlm_quantumkeeper.h"
 
 #include "../common/gp_mm.h"
+#include "../common/random_source.h"
 #include <fstream>
 
 static ofstream fout("snooping.log");
@@ -225,6 +227,7 @@ struct Initiator: sc_module
   Initiator(sc_module_name _n, gp_mm* mm)
   : socket("socket")
   , m_mm(mm)
+  , m_random(name())
   {
     socket.register_invalidate_direct_mem_ptr(this, &Initiator::invalidate_direct_mem_ptr);
 
@@ -244,8 +247,8 @@ struct Initiator: sc_module
     // Generate a random sequence of reads and writes
     for (int i = 0; i < 64; i++)
     {
-      sc_dt::uint64 addr = (rand() % 128) << 2;
-      tlm::tlm_command cmd = static_cast<tlm::tlm_command>(rand() % 2);
+      sc_dt::uint64 addr = m_random.below(128) << 2;
+      tlm::tlm_command cmd = static_cast<tlm::tlm_command>(m_random.below(2));
       if (cmd == tlm::TLM_WRITE_COMMAND) data = int(addr);
 
       // Check DMI table
@@ -350,6 +353,7 @@ struct Initiator: sc_module
   int data;                            // Internal data buffer used with generic payload
   tlm_utils::tlm_quantumkeeper m_qk;   // Quantum keeper for temporal decoupling
   std::vector<tlm::tlm_dmi> dmi_table; // Table of valid DMI regions
+  Random_stream m_random;
 };
 
 
@@ -484,14 +488,16 @@ struct Memory: sc_module
   : socket("socket")
   , LATENCY(50, SC_NS)
   , write_snoop(false)
+  , m_random(name())
   {
     socket.register_b_transport       (this, &Memory ::b_transport);
     socket.register_get_direct_mem_ptr(this, &Memory ::get_direct_mem_ptr);
     socket.register_transport_dbg     (this, &Memory ::transport_dbg);
 
     // Initialize memory with random data
+    m_random.fill( mem, sizeof(mem) );
     for (int i = 0; i < SIZE; i++)
-      mem[i] = rand() % 256;
+      mem[i] &= 0xFF;
   }
 
 
@@ -629,6 +635,7 @@ struct Memory: sc_module
   bool write_snoop;
   sc_dt::uint64 snoop_start_address;
   sc_dt::uint64 snoop_end_address;
+  Random_stream m_random;
 };
 
 
@@ -0,0 +1,62 @@
+
+// Filename: checker_replay.cpp
+
+//----------------------------------------------------------------------
+//  Licensed under the Apache License, Version 2.0 (the "License");
+//  you may not use this file except in compliance with the License.
+//  You may obtain a copy of the License at
+//
+//  http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+//----------------------------------------------------------------------
+
+// Version 1  16-Oct-2026
+// Version 2  16-Oct-2026  Needs the list of processes beside the log
+
+/*
+
+Offline protocol checker
+
+Replays an event log written by tlm2_logging_checker (see tlm2_checker_log.h) through
+one tlm2_base_protocol_checker per logged hop. Violations are reported by the checkers
+exactly as they would have been inline, naming the original checker instance, except
+that the time in the report is 0 and the time of the call is shown by the annotated delay.
+The calls of each logged process are made from a thread of its own, so a b_transport that
+waited in the original run is replayed with the calls other processes made meanwhile.
+
+The files <event log>.hops and <event log>.processes written by tlm2_event_log::close()
+must be beside the log.
+
+The log must have been written with the same time resolution as the one used here,
+which is the SystemC default of 1 ps.
+
+Usage: out [event log, default tlm2_events.bin]
+
+*/
+
+#include "tlm2_checker_log.h"
+
+using namespace sc_core;
+using namespace std;
+
+
+int sc_main(int argc, char* argv[])
+{
+  string filename = argc > 1 ? argv[1] : "tlm2_events.bin";
+
+  // Report every violation, however many there are
+  sc_report_handler::set_actions("tlm2_protocol_checker", SC_ERROR, SC_DISPLAY | SC_LOG);
+
+  tlm_utils::tlm2_log_replayer replayer("replay", filename);
+  sc_start();
+
+  cout << replayer.records << " records replayed, "
+       << sc_report_handler::get_count(SC_ERROR) << " errors, "
+       << sc_report_handler::get_count(SC_WARNING) << " warnings" << endl;
+  return sc_report_handler::get_count(SC_ERROR) ? 1 : 0;
+}
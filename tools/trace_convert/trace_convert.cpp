@@ -0,0 +1,145 @@
+
+// Filename: trace_convert.cpp
+
+//----------------------------------------------------------------------
+//  Licensed under the Apache License, Version 2.0 (the "License");
+//  you may not use this file except in compliance with the License.
+//  You may obtain a copy of the License at
+//
+//  http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+//----------------------------------------------------------------------
+
+// Version 1  16-Oct-2026
+
+/*
+
+Trace converter
+
+Turns a text memory-access trace into the binary trace replayed by Trace_replay (see
+trace_file.h). The text has one access per line, with # comments:
+
+  # time (ns)   address      size   command
+  0             0x80000000   64     R
+  12.5          0x80000040   64     W
+
+The times are absolute and must not decrease. Numbers may be decimal or 0x-prefixed hex,
+and the command is R, W, read or write in either case. The size must lie between 1 and
+65535 bytes.
+
+Usage: out <text trace> <binary trace>
+
+*/
+
+#include "trace_file.h"
+#include "binary_log.h"
+
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <cstdlib>
+#include <cmath>
+
+using namespace sc_core;
+using namespace std;
+
+
+static bool command( string s, unsigned char& cmd )
+{
+  for (unsigned int i = 0; i < s.size(); i++)
+    s[i] = tolower(s[i]);
+  if (s == "r" || s == "read")
+    cmd = Trace_record::READ;
+  else if (s == "w" || s == "write")
+    cmd = Trace_record::WRITE;
+  else
+    return false;
+  return true;
+}
+
+
+int sc_main(int argc, char* argv[])
+{
+  if (argc != 3)
+  {
+    cerr << "Usage: " << argv[0] << " <text trace> <binary trace>" << endl;
+    return 1;
+  }
+
+  ifstream in( argv[1] );
+  if (!in)
+  {
+    cerr << "Cannot open " << argv[1] << endl;
+    return 1;
+  }
+
+  Binary_log<Trace_record> out;
+  if (!out.open( argv[2], "TLMTRACE" ))
+  {
+    cerr << "Cannot create " << argv[2] << endl;
+    return 1;
+  }
+
+  string line;
+  unsigned int line_nr = 0;
+  sc_dt::uint64 last_ps = 0, n_idle = 0;
+  while (getline(in, line))
+  {
+    line_nr++;
+    string::size_type hash = line.find('#');
+    if (hash != string::npos)
+      line.erase(hash);
+
+    istringstream fields(line);
+    string tok[4], extra;
+    int n = 0;
+    while (n < 4 && fields >> tok[n])
+      n++;
+    if (n == 0)
+      continue;
+
+    Trace_record r;
+    memset( &r, 0, sizeof(r) );
+
+    char* end[3];
+    double        ns   = strtod( tok[0].c_str(), &end[0] );
+    sc_dt::uint64 size = strtoull( tok[2].c_str(), &end[2], 0 );
+    r.address          = strtoull( tok[1].c_str(), &end[1], 0 );
+    sc_dt::uint64 ps   = sc_dt::uint64( floor(ns * 1000 + 0.5) );
+
+    if (n < 4 || (fields >> extra) || *end[0] || *end[1] || *end[2] || !command(tok[3], r.command)
+     || ns < 0 || size == 0 || size > 0xFFFF || ps < last_ps)
+    {
+      cerr << argv[1] << ":" << line_nr << ": expected <time> <address> <size> <R|W>"
+           << ", with times in order and a size from 1 to 65535" << endl;
+      return 1;
+    }
+    r.size = (unsigned short)size;
+
+    // Gaps longer than 32 bits of picoseconds are carried by IDLE records
+    sc_dt::uint64 gap = ps - last_ps;
+    last_ps = ps;
+    while (gap > 0xFFFFFFFFULL)
+    {
+      Trace_record idle;
+      memset( &idle, 0, sizeof(idle) );
+      idle.gap     = 0xFFFFFFFFU;
+      idle.command = Trace_record::IDLE;
+      out.append( idle );
+      gap -= idle.gap;
+      n_idle++;
+    }
+    r.gap = (unsigned int)gap;
+    out.append( r );
+  }
+  out.close();
+
+  cout << out.written() - n_idle << " accesses written to " << argv[2] << endl;
+  return 0;
+}
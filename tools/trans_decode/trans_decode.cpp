@@ -0,0 +1,79 @@
+
+// Filename: trans_decode.cpp
+
+//----------------------------------------------------------------------
+//  Licensed under the Apache License, Version 2.0 (the "License");
+//  you may not use this file except in compliance with the License.
+//  You may obtain a copy of the License at
+//
+//  http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+//----------------------------------------------------------------------
+
+// Version 1  16-Oct-2026
+// Version 2  16-Oct-2026  Decode the logs of TLM-2.0-Example6
+
+/*
+
+Transaction log decoder
+
+Turns a binary transaction log (see transaction_log.h) back into the text that the
+initiators and targets write when the log is not open, line for line. The module names
+are read from the .modules file written beside the log. The log of TLM-2.0-Example6 is
+recognized by its magic string and decoded to the text of that example.
+
+The log must have been written with the same time resolution as the one used here,
+which is the SystemC default of 1 ps.
+
+Usage: out [transaction log, default example.bin] [text file, default example.log]
+
+*/
+
+#include "transaction_log.h"
+
+#include <iostream>
+
+using namespace sc_core;
+using namespace std;
+
+
+int sc_main(int argc, char* argv[])
+{
+  string filename = argc > 1 ? argv[1] : "example.bin";
+  string textname = argc > 2 ? argv[2] : "example.log";
+
+  vector<string> names;
+  ifstream modules( (filename + ".modules").c_str() );
+  string name;
+  while (getline(modules, name))
+    names.push_back(name);
+
+  Transaction_record::style_t style = Transaction_record::AT_EXAMPLE;
+  Binary_log_reader<Transaction_record> log;
+  if (!log.open( filename.c_str(), Transaction_log::magic(style) ))
+  {
+    style = Transaction_record::EXAMPLE6;
+    if (!log.open( filename.c_str(), Transaction_log::magic(style) ))
+    {
+      cerr << filename << " is not a transaction log" << endl;
+      return 1;
+    }
+  }
+
+  ofstream text( textname.c_str() );
+  Transaction_record r;
+  sc_dt::uint64 n = 0;
+  while (log.next(r))
+  {
+    Transaction_log::format( text, r, r.module < names.size() ? names[r.module] : "?", style );
+    n++;
+  }
+
+  cout << n << " records decoded to " << textname << endl;
+  return 0;
+}